@@ -0,0 +1,201 @@
+#include "Harness.h"
+
+#include <Tsubasa/Math/Simd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <thread>
+
+namespace Tsubasa
+{
+    namespace Bench
+    {
+        namespace
+        {
+            const uint64_t MaxIterations = 1000000000;
+
+            uint64_t now()
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            }
+
+            const char *simdName()
+            {
+#if defined(TSUBASA_AVX)
+                return "AVX";
+#elif defined(TSUBASA_SSE)
+                return "SSE";
+#else
+                return "None";
+#endif
+            }
+
+            void writeEscaped(std::ostream &stream, const std::string &text)
+            {
+                for (const char &character : text)
+                {
+                    if (character == '"' || character == '\\')
+                    {
+                        stream << '\\';
+                    }
+                    stream << character;
+                }
+            }
+        }
+
+        State::State(const uint64_t &iterations) : Iterations(iterations)
+        {
+            elapsed = 0;
+            running = false;
+            start = 0;
+        }
+
+        void State::Pause()
+        {
+            if (running)
+            {
+                elapsed += now() - start;
+                running = false;
+            }
+        }
+
+        void State::Resume()
+        {
+            if (!running)
+            {
+                start = now();
+                running = true;
+            }
+        }
+
+        Harness::Harness(int argc, char **argv) : Results(results)
+        {
+            minTime = 0.2;
+            repetitions = 5;
+            for (int i = 1; i < argc; i++)
+            {
+                const std::string argument = argv[i];
+                if (i + 1 >= argc)
+                {
+                    throw std::runtime_error("Missing value for benchmark option " + argument + ".");
+                }
+                if (argument == "--json")
+                {
+                    jsonPath = argv[++i];
+                }
+                else if (argument == "--filter")
+                {
+                    filter = argv[++i];
+                }
+                else if (argument == "--min-time")
+                {
+                    minTime = std::stod(argv[++i]);
+                }
+                else if (argument == "--repetitions")
+                {
+                    repetitions = std::max(1, std::stoi(argv[++i]));
+                }
+                else
+                {
+                    throw std::runtime_error("Unknown benchmark option " + argument + ".");
+                }
+            }
+        }
+
+        Harness::~Harness() {}
+
+        void Harness::Add(const std::string &name, const uint64_t &items, const Body &body)
+        {
+            cases.push_back({name, items, body});
+        }
+
+        void Harness::Run()
+        {
+            std::printf("%-48s %14s %14s %14s %16s\n", "Benchmark", "Iterations", "ns/iter", "Min ns", "Items/s");
+            for (Case &benchmark : cases)
+            {
+                if (benchmark.Name.find(filter) == std::string::npos)
+                {
+                    continue;
+                }
+                results.push_back(measure(benchmark));
+                // Drops the fixtures captured by the body before the next benchmark
+                benchmark.Function = nullptr;
+                const Result &result = results.back();
+                std::printf("%-48s %14llu %14.2f %14.2f %16.4g\n", result.Name.c_str(), (unsigned long long)result.Iterations,
+                            result.Median, result.Min, result.Items * 1.0e9 / result.Median);
+                std::fflush(stdout);
+            }
+            if (!jsonPath.empty())
+            {
+                writeJson();
+            }
+        }
+
+        Harness::Result Harness::measure(Case &benchmark) const
+        {
+            // Grow the iteration count until a run reaches the minimum time
+            uint64_t iterations = 1;
+            double seconds = time(benchmark, iterations);
+            while (seconds < minTime && iterations < MaxIterations)
+            {
+                const double estimate = seconds > 0.0 ? minTime * 1.2 / seconds : 10.0;
+                iterations = std::min(MaxIterations, (uint64_t)(iterations * std::min(10.0, std::max(2.0, estimate))));
+                seconds = time(benchmark, iterations);
+            }
+
+            std::vector<double> samples;
+            samples.push_back(seconds * 1.0e9 / iterations);
+            for (unsigned int i = 1; i < repetitions; i++)
+            {
+                samples.push_back(time(benchmark, iterations) * 1.0e9 / iterations);
+            }
+            std::sort(samples.begin(), samples.end());
+            return {benchmark.Name, iterations, benchmark.Items, samples[samples.size() / 2], samples.front(), samples.back()};
+        }
+
+        void Harness::writeJson() const
+        {
+            std::ofstream stream(jsonPath);
+            if (!stream)
+            {
+                throw std::runtime_error("Failed to open benchmark report file.");
+            }
+            char date[32];
+            const std::time_t clock = std::time(nullptr);
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&clock));
+
+            stream << std::fixed << std::setprecision(3) << "{\n\"context\":{\"date\":\"" << date
+                   << "\",\"simd\":\"" << simdName() << "\",\"threads\":" << std::thread::hardware_concurrency()
+                   << ",\"min_time\":" << minTime << ",\"repetitions\":" << repetitions << "},\n\"benchmarks\":[";
+            bool first = true;
+            for (const Result &result : results)
+            {
+                stream << (first ? "" : ",") << "\n{\"name\":\"";
+                writeEscaped(stream, result.Name);
+                stream << "\",\"iterations\":" << result.Iterations << ",\"items_per_iteration\":" << result.Items
+                       << ",\"ns_per_iteration\":" << result.Median << ",\"min_ns\":" << result.Min << ",\"max_ns\":" << result.Max
+                       << ",\"items_per_second\":" << result.Items * 1.0e9 / result.Median << "}";
+                first = false;
+            }
+            stream << "\n]}\n";
+            if (!stream)
+            {
+                throw std::runtime_error("Failed to write benchmark report file.");
+            }
+        }
+
+        double Harness::time(Case &benchmark, const uint64_t &iterations)
+        {
+            State state(iterations);
+            state.Resume();
+            benchmark.Function(state);
+            state.Pause();
+            return state.elapsed / 1.0e9;
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Tsubasa
+{
+    namespace Bench
+    {
+        // Keeps the compiler from discarding a value computed by a benchmark
+        template <typename T>
+        inline void Keep(const T &value)
+        {
+#if defined(__GNUC__)
+            asm volatile("" : : "r"(&value) : "memory");
+#else
+            static const void *volatile sink;
+            sink = &value;
+#endif
+        }
+
+        // Passed to every benchmark body, which runs its operation Iterations
+        // times. Work between Pause() and Resume() is left out of the timing.
+        class State
+        {
+            friend class Harness;
+        public:
+            State(const uint64_t &iterations);
+
+            void Pause();
+            void Resume();
+
+            const uint64_t Iterations;
+
+        private:
+            uint64_t start;
+            uint64_t elapsed;
+            bool running;
+        };
+
+        // Self-contained benchmark runner. Each benchmark is calibrated until
+        // one run takes at least the minimum time, then repeated and reported
+        // as nanoseconds per iteration.
+        class Harness
+        {
+        public:
+            using Body = std::function<void(State &state)>;
+
+            struct Result
+            {
+                std::string Name;
+                uint64_t Iterations;
+                // Items processed per iteration, for the throughput column
+                uint64_t Items;
+                double Median;
+                double Min;
+                double Max;
+            };
+
+            // Reads --json <path>, --filter <text>, --min-time <seconds> and
+            // --repetitions <count>
+            Harness(int argc, char **argv);
+            ~Harness();
+
+            void Add(const std::string &name, const uint64_t &items, const Body &body);
+            // Runs the benchmarks whose name contains the filter, prints a
+            // table and writes the JSON report when requested
+            void Run();
+
+            const std::vector<Result> &Results;
+
+        private:
+            struct Case
+            {
+                std::string Name;
+                uint64_t Items;
+                Body Function;
+            };
+
+            std::vector<Case> cases;
+            std::vector<Result> results;
+            std::string filter;
+            std::string jsonPath;
+            double minTime;
+            unsigned int repetitions;
+
+            Result measure(Case &benchmark) const;
+            void writeJson() const;
+
+            static double time(Case &benchmark, const uint64_t &iterations);
+        };
+    }
+}
@@ -0,0 +1,541 @@
+#include "Harness.h"
+
+#include <Tsubasa/Application.h>
+#include <Tsubasa/Component.h>
+#include <Tsubasa/Node.h>
+#include <Tsubasa/System.h>
+#include <Tsubasa/TransformStore.h>
+#include <Tsubasa/Math/Affine3x4.h>
+#include <Tsubasa/Math/Batch.h>
+#include <Tsubasa/Math/Matrix4x4.h>
+#include <Tsubasa/Math/Quaternion.h>
+#include <Tsubasa/Math/Vector3.h>
+#include <Tsubasa/Rendering/RenderQueue.h>
+#include <Tsubasa/Spatial/BoundingVolumeTree.h>
+#include <Tsubasa/Threading/JobSystem.h>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Tsubasa;
+using namespace Tsubasa::Bench;
+
+namespace
+{
+    const size_t MathCount = 1024;
+
+    struct MathData
+    {
+        std::vector<Vector3> Positions, Scales, Points;
+        std::vector<Quaternion> Rotations, OtherRotations;
+        std::vector<Matrix4x4> Matrices, OtherMatrices;
+        std::vector<Affine3x4> Affines, OtherAffines;
+
+        MathData()
+        {
+            std::mt19937 random(7);
+            std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+            auto vector = [&]()
+            { return Vector3(unit(random), unit(random), unit(random)); };
+            for (size_t i = 0; i < MathCount; i++)
+            {
+                Positions.push_back(vector() * 10.0f);
+                Scales.push_back(Vector3(1.5f, 1.5f, 1.5f) + vector());
+                Points.push_back(vector() * 5.0f);
+                Rotations.push_back(Quaternion::FromEuler(vector() * 3.0f));
+                OtherRotations.push_back(Quaternion::FromEuler(vector() * 3.0f));
+                Matrices.push_back(Matrix4x4::TRS(Positions[i], Rotations[i], Scales[i]));
+                OtherMatrices.push_back(Matrix4x4::TRS(vector(), OtherRotations[i], Scales[i]));
+                Affines.push_back(Affine3x4(Matrices[i]));
+                OtherAffines.push_back(Affine3x4(OtherMatrices[i]));
+            }
+        }
+    };
+
+    std::shared_ptr<Node> buildChain(const size_t &depth)
+    {
+        std::shared_ptr<Node> root = std::make_shared<Node>();
+        std::shared_ptr<Node> node = root;
+        for (size_t i = 1; i < depth; i++)
+        {
+            node = node->AddChild();
+            node->SetLocalPosition(0.0f, 1.0f, 0.0f);
+            node->SetLocalRotation(0.0f, 0.01f, 0.0f);
+        }
+        return root;
+    }
+
+    std::shared_ptr<Node> buildWide(const size_t &count)
+    {
+        std::shared_ptr<Node> root = std::make_shared<Node>();
+        for (size_t i = 1; i < count; i++)
+        {
+            root->AddChild()->SetLocalPosition((float)i, 0.0f, 0.0f);
+        }
+        return root;
+    }
+
+    void buildBranches(const std::shared_ptr<Node> &node, const size_t &branching, const size_t &depth)
+    {
+        for (size_t i = 0; depth > 1 && i < branching; i++)
+        {
+            const std::shared_ptr<Node> child = node->AddChild();
+            child->SetLocalPosition((float)i, 1.0f, 0.0f);
+            buildBranches(child, branching, depth - 1);
+        }
+    }
+
+    // Owns a tree for the lifetime of one benchmark
+    struct TreeFixture
+    {
+        std::shared_ptr<Node> Root;
+        std::unique_ptr<JobSystem> Jobs;
+    };
+
+    class ComponentA : public Component
+    {
+    public:
+        float Value = 0.0f;
+    };
+    class ComponentB : public Component
+    {
+    public:
+        float Value = 0.0f;
+    };
+    class ComponentC : public Component
+    {
+    public:
+        float Value = 0.0f;
+    };
+    class ComponentD : public Component
+    {
+    public:
+        float Value = 0.0f;
+    };
+
+    class SpinComponent : public Component
+    {
+    public:
+        void OnUpdate(float timeDelta) override
+        {
+            Entity->Rotate(0.0f, timeDelta, 0.0f);
+        }
+    };
+
+    // Stops the application after a set number of frames
+    class FrameLimitSystem : public System
+    {
+    public:
+        uint64_t Frames = 1;
+
+        void OnInit() override
+        {
+            remaining = Frames;
+        }
+
+        bool OnUpdate(float) override
+        {
+            return --remaining > 0;
+        }
+
+    private:
+        uint64_t remaining = 0;
+    };
+
+    struct FrameFixture
+    {
+        std::shared_ptr<Application> Client;
+        std::shared_ptr<FrameLimitSystem> Limit;
+
+        FrameFixture(const size_t &count)
+        {
+            Client = std::make_shared<Application>();
+            Limit = Client->AddSystem<FrameLimitSystem>();
+            for (size_t i = 0; i < count; i++)
+            {
+                const std::shared_ptr<Node> node = Client->Root->AddChild();
+                node->SetLocalPosition((float)i, 0.0f, 0.0f);
+                node->AddComponent<SpinComponent>();
+            }
+        }
+    };
+
+    void addMathBenchmarks(Harness &harness)
+    {
+        std::shared_ptr<MathData> data = std::make_shared<MathData>();
+
+        harness.Add("Matrix4x4/Multiply", MathCount, [data](State &state)
+                    {
+            std::vector<Matrix4x4> result(MathCount);
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                for (size_t i = 0; i < MathCount; i++)
+                {
+                    result[i] = data->Matrices[i] * data->OtherMatrices[i];
+                }
+                Keep(result[0]);
+            } });
+        harness.Add("Matrix4x4/Inversed", MathCount, [data](State &state)
+                    {
+            std::vector<Matrix4x4> result(MathCount);
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                for (size_t i = 0; i < MathCount; i++)
+                {
+                    result[i] = data->Matrices[i].Inversed();
+                }
+                Keep(result[0]);
+            } });
+        harness.Add("Matrix4x4/TRS", MathCount, [data](State &state)
+                    {
+            std::vector<Matrix4x4> result(MathCount);
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                for (size_t i = 0; i < MathCount; i++)
+                {
+                    result[i] = Matrix4x4::TRS(data->Positions[i], data->Rotations[i], data->Scales[i]);
+                }
+                Keep(result[0]);
+            } });
+        harness.Add("Matrix4x4/TransformPoint", MathCount, [data](State &state)
+                    {
+            std::vector<Vector3> result(MathCount);
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                for (size_t i = 0; i < MathCount; i++)
+                {
+                    result[i] = data->Matrices[0] * data->Points[i];
+                }
+                Keep(result[0]);
+            } });
+        harness.Add("Affine3x4/Multiply", MathCount, [data](State &state)
+                    {
+            std::vector<Affine3x4> result(MathCount);
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                for (size_t i = 0; i < MathCount; i++)
+                {
+                    result[i] = data->Affines[i] * data->OtherAffines[i];
+                }
+                Keep(result[0]);
+            } });
+        harness.Add("Affine3x4/Inversed", MathCount, [data](State &state)
+                    {
+            std::vector<Affine3x4> result(MathCount);
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                for (size_t i = 0; i < MathCount; i++)
+                {
+                    result[i] = data->Affines[i].Inversed();
+                }
+                Keep(result[0]);
+            } });
+        harness.Add("Quaternion/Multiply", MathCount, [data](State &state)
+                    {
+            std::vector<Quaternion> result(MathCount);
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                for (size_t i = 0; i < MathCount; i++)
+                {
+                    result[i] = data->Rotations[i] * data->OtherRotations[i];
+                }
+                Keep(result[0]);
+            } });
+        harness.Add("Quaternion/RotateVector", MathCount, [data](State &state)
+                    {
+            std::vector<Vector3> result(MathCount);
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                for (size_t i = 0; i < MathCount; i++)
+                {
+                    result[i] = data->Rotations[i] * data->Points[i];
+                }
+                Keep(result[0]);
+            } });
+        harness.Add("Quaternion/Slerp", MathCount, [data](State &state)
+                    {
+            std::vector<Quaternion> result(MathCount);
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                for (size_t i = 0; i < MathCount; i++)
+                {
+                    result[i] = Quaternion::Slerp(data->Rotations[i], data->OtherRotations[i], 0.3f);
+                }
+                Keep(result[0]);
+            } });
+        harness.Add("Quaternion/FromEuler", MathCount, [data](State &state)
+                    {
+            std::vector<Quaternion> result(MathCount);
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                for (size_t i = 0; i < MathCount; i++)
+                {
+                    result[i] = Quaternion::FromEuler(data->Points[i]);
+                }
+                Keep(result[0]);
+            } });
+        harness.Add("Batch/TRS", MathCount, [data](State &state)
+                    {
+            std::vector<Affine3x4> result(MathCount);
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                TRSBatch(data->Positions, data->Rotations, data->Scales, result);
+                Keep(result[0]);
+            } });
+        harness.Add("Batch/MultiplyAffine", MathCount, [data](State &state)
+                    {
+            std::vector<Affine3x4> result(MathCount);
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                MultiplyBatch(data->Affines, data->OtherAffines, result);
+                Keep(result[0]);
+            } });
+        harness.Add("Batch/TransformPoints", MathCount, [data](State &state)
+                    {
+            std::vector<Vector3> result(MathCount);
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                TransformPoints(data->Matrices[0], data->Points, result);
+                Keep(result[0]);
+            } });
+        harness.Add("Batch/QuaternionSlerp", MathCount, [data](State &state)
+                    {
+            std::vector<Quaternion> result(MathCount);
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                QuaternionSlerpBatch(data->Rotations, data->OtherRotations, 0.3f, result);
+                Keep(result[0]);
+            } });
+    }
+
+    void addSceneBenchmarks(Harness &harness)
+    {
+        harness.Add("Node/AddChild", 1, [](State &state)
+                    {
+            std::shared_ptr<Node> root = std::make_shared<Node>();
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                Keep(root->AddChild());
+            }
+            state.Pause();
+            root = nullptr;
+            state.Resume(); });
+        harness.Add("Node/AddChild/Arena", 1, [](State &state)
+                    {
+            state.Pause();
+            std::shared_ptr<Application> client = std::make_shared<Application>();
+            client->UseArena();
+            state.Resume();
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                Keep(client->Root->AddChild());
+            }
+            state.Pause();
+            client = nullptr;
+            state.Resume(); });
+        harness.Add("Node/SetParent", 1, [](State &state)
+                    {
+            state.Pause();
+            std::shared_ptr<Node> first = std::make_shared<Node>();
+            std::shared_ptr<Node> second = std::make_shared<Node>();
+            std::shared_ptr<Node> child = first->AddChild();
+            buildBranches(child, 2, 4);
+            state.Resume();
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                child->SetParent(n % 2 == 0 ? second : first);
+            }
+            state.Pause();
+            first = nullptr;
+            second = nullptr;
+            child = nullptr;
+            state.Resume(); });
+
+        auto traverse = std::make_shared<TreeFixture>();
+        harness.Add("Node/Traverse/4^6", 5461, [traverse](State &state)
+                    {
+            if (traverse->Root == nullptr)
+            {
+                state.Pause();
+                traverse->Root = std::make_shared<Node>();
+                buildBranches(traverse->Root, 4, 7);
+                state.Resume();
+            }
+            size_t visited = 0;
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                traverse->Root->Traverse([&visited](Node &)
+                                     { visited++; });
+            }
+            Keep(visited); });
+
+        auto lookup = std::make_shared<TreeFixture>();
+        harness.Add("Node/GetComponent", 1, [lookup](State &state)
+                    {
+            if (lookup->Root == nullptr)
+            {
+                state.Pause();
+                lookup->Root = std::make_shared<Node>();
+                lookup->Root->AddComponent<ComponentA>();
+                lookup->Root->AddComponent<ComponentB>();
+                lookup->Root->AddComponent<ComponentC>();
+                lookup->Root->AddComponent<ComponentD>();
+                state.Resume();
+            }
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                Keep(lookup->Root->GetComponent<ComponentC>());
+            } });
+    }
+
+    void addTransformBenchmark(Harness &harness, const std::string &name, const size_t &nodes, const bool &parallel,
+                               const std::function<std::shared_ptr<Node>()> &build)
+    {
+        auto fixture = std::make_shared<TreeFixture>();
+        harness.Add(name, nodes, [fixture, parallel, build](State &state)
+                    {
+            if (fixture->Root == nullptr)
+            {
+                state.Pause();
+                fixture->Root = build();
+                if (parallel)
+                {
+                    fixture->Jobs = std::make_unique<JobSystem>();
+                }
+                state.Resume();
+            }
+            TransformStore &store = TransformStore::Shared();
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                // Moving the root dirties the whole tree
+                fixture->Root->SetLocalPosition((float)(n % 2), 0.0f, 0.0f);
+                store.Update(fixture->Jobs.get());
+            } });
+    }
+
+    void addTransformBenchmarks(Harness &harness)
+    {
+        addTransformBenchmark(harness, "Transform/Deep/1000", 1000, false, []()
+                              { return buildChain(1000); });
+        addTransformBenchmark(harness, "Transform/Wide/10000", 10000, false, []()
+                              { return buildWide(10000); });
+        addTransformBenchmark(harness, "Transform/Wide/10000/Jobs", 10000, true, []()
+                              { return buildWide(10000); });
+        addTransformBenchmark(harness, "Transform/Tree/4^6", 5461, false, []()
+                              {
+            std::shared_ptr<Node> root = std::make_shared<Node>();
+            buildBranches(root, 4, 7);
+            return root; });
+        addTransformBenchmark(harness, "Transform/Tree/4^6/Jobs", 5461, true, []()
+                              {
+            std::shared_ptr<Node> root = std::make_shared<Node>();
+            buildBranches(root, 4, 7);
+            return root; });
+    }
+
+    void addRenderBenchmarks(Harness &harness)
+    {
+        const size_t count = 10000;
+        harness.Add("RenderQueue/Sort/" + std::to_string(count), count, [count](State &state)
+                    {
+            std::mt19937 random(7);
+            std::uniform_real_distribution<float> depth(0.1f, 100.0f);
+            RenderQueue queue;
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                state.Pause();
+                queue.Clear();
+                for (size_t i = 0; i < count; i++)
+                {
+                    const uint64_t key = RenderQueue::MakeKey(i % 8 == 0, 1 + i % 3, i % 16, i % 32, depth(random));
+                    queue.Add(key, nullptr, 0, Affine3x4::Identity);
+                }
+                state.Resume();
+                queue.Sort();
+                Keep(queue[0]);
+            } });
+    }
+
+    void addSpatialBenchmarks(Harness &harness)
+    {
+        const size_t count = 10000;
+        auto boxes = std::make_shared<std::vector<Bounds>>();
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> extent(0.25f, 2.0f);
+        for (size_t i = 0; i < count; i++)
+        {
+            boxes->push_back(Bounds(Vector3(position(random), position(random), position(random)), Vector3(extent(random), extent(random), extent(random))));
+        }
+
+        harness.Add("BoundingVolumeTree/Insert/" + std::to_string(count), count, [boxes](State &state)
+                    {
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                BoundingVolumeTree tree;
+                for (const auto &box : *boxes)
+                {
+                    tree.Insert(box);
+                }
+                Keep(tree.GetHeight());
+            } });
+        auto tree = std::make_shared<BoundingVolumeTree>();
+        for (const auto &box : *boxes)
+        {
+            tree->Insert(box);
+        }
+        harness.Add("BoundingVolumeTree/QuerySphere", 1, [tree, boxes](State &state)
+                    {
+            size_t found = 0;
+            for (uint64_t n = 0; n < state.Iterations; n++)
+            {
+                tree->Query((*boxes)[n % boxes->size()].Center, 5.0f, [&found](const uint32_t &)
+                            { found++; });
+            }
+            Keep(found); });
+    }
+
+    void addFrameBenchmarks(Harness &harness)
+    {
+        for (const auto &count : {100, 1000, 10000})
+        {
+            auto fixture = std::make_shared<std::unique_ptr<FrameFixture>>();
+            harness.Add("Application/Frame/" + std::to_string(count), count, [fixture, count](State &state)
+                        {
+                if (*fixture == nullptr)
+                {
+                    state.Pause();
+                    *fixture = std::make_unique<FrameFixture>(count);
+                    state.Resume();
+                }
+                // Run() repeats the init and start callbacks, which are empty here
+                (*fixture)->Limit->Frames = state.Iterations;
+                (*fixture)->Client->Run(); });
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        Harness harness(argc, argv);
+        addMathBenchmarks(harness);
+        addSceneBenchmarks(harness);
+        addTransformBenchmarks(harness);
+        addRenderBenchmarks(harness);
+        addSpatialBenchmarks(harness);
+        addFrameBenchmarks(harness);
+        harness.Run();
+    }
+    catch (const std::exception &exception)
+    {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
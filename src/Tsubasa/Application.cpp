@@ -1,18 +1,37 @@
 #include <Tsubasa/Application.h>
-#include <Tsubasa/Math/Matrix4x4.h>
+#include <Tsubasa/Profiling/Profiler.h>
+#include <Tsubasa/TransformStore.h>
 #include <algorithm>
-#include <chrono>
+#include <atomic>
+#include <cmath>
+#include <typeinfo>
 
 namespace Tsubasa
 {
-    Application::Application() : Root(root), Systems(systems)
+    Application::Application() : Interpolation(interpolation), Root(root), Spatial(spatial), Systems(systems), Jobs(jobs)
     {
         running = false;
-        root = std::make_shared<Node>();
+        scheduleValid = false;
+        accumulator = 0.0f;
+        interpolation = 1.0f;
+        FixedUpdateRate = 0.0f;
+        MaxFixedSteps = 5;
+        MaxFrames = 0;
+        root = std::allocate_shared<Node>(ChunkAllocator<Node>());
+        root->setApplication(this);
         ActiveCamera = nullptr;
     }
 
-    Application::~Application() {}
+    Application::~Application()
+    {
+        // Nodes and systems that outlive the application are left detached
+        root->setApplication(nullptr);
+        TransformStore::Shared().ReleaseMoved(this);
+        for (const auto &system : systems)
+        {
+            system->application = nullptr;
+        }
+    }
 
     bool Application::HasSystem(const std::shared_ptr<System> &system) const
     {
@@ -27,14 +46,54 @@ namespace Tsubasa
             system->OnExit();
             systems.erase(it);
             system->application = nullptr;
+            scheduleValid = false;
+            if (systemTable[system->typeId] == system)
+            {
+                // Fall back to another system of the same type, if any
+                systemTable[system->typeId] = nullptr;
+                for (const auto &other : systems)
+                {
+                    if (other->typeId == system->typeId)
+                    {
+                        systemTable[system->typeId] = other;
+                        break;
+                    }
+                }
+            }
             return system;
         }
         return nullptr;
     }
 
+    void Application::UseArena(const size_t &blockSize)
+    {
+        if (arena == nullptr)
+        {
+            arena = std::make_shared<Arena>(blockSize);
+        }
+    }
+
+    const std::shared_ptr<Arena> &Application::GetArena() const
+    {
+        return arena;
+    }
+
+    void Application::Unload()
+    {
+        ActiveCamera = nullptr;
+        while (!root->children.empty())
+        {
+            const std::shared_ptr<Node> child = root->children.back();
+            root->RemoveChild(child);
+        }
+        if (arena != nullptr && !arena->Release())
+        {
+            arena = std::make_shared<Arena>(arena->GetBlockSize());
+        }
+    }
+
     void Application::Run()
     {
-        Root->application = shared_from_this();
         OnInit();
         for (const auto &system : systems)
         {
@@ -42,54 +101,61 @@ namespace Tsubasa
         }
         OnStart();
         float timeDelta = 0.0f;
+        uint64_t frames = 0;
+        accumulator = 0.0f;
+        interpolation = 1.0f;
         running = true;
+        Pacer.Reset();
         while (running)
         {
-            auto begin = std::chrono::high_resolution_clock::now();
-            // Component->OnUpdate
-            Root->Traverse([timeDelta](const std::shared_ptr<Node> &node)
-                           {
-                for (const auto &component : node->Components)
-                {
-                    if (component->Enabled)
-                    {
-                        component->OnUpdate(timeDelta);
-                    }
-                } });
+            TSUBASA_PROFILE_FRAME_BEGIN();
+            // Fixed steps
+            if (FixedUpdateRate > 0.0f)
+            {
+                TSUBASA_PROFILE_SCOPE("FixedUpdate");
+                fixedUpdate(timeDelta);
+            }
+            else
+            {
+                interpolation = 1.0f;
+            }
+            // Component->OnUpdate, batched per type
+            {
+                TSUBASA_PROFILE_SCOPE("Component::OnUpdate");
+                ComponentRegistry::Shared().Update(this, timeDelta);
+            }
             // Calculate transforms
-            Root->Traverse([](const std::shared_ptr<Node> &node)
-                           {
-                // node->transform = Matrix4x4::Scale(node->LocalScale) * Matrix4x4::Rotate(node->LocalRotation) * Matrix4x4::Translate(node->LocalPosition);
-                if (node->dirty)
-                {
-                    if (node->Parent)
-                    {
-                        node->transform = Matrix4x4::TRS(node->LocalPosition, node->LocalRotation, node->LocalScale) * node->Parent->Transform;
-                    }
-                    else
-                    {
-                        node->transform = Matrix4x4::TRS(node->LocalPosition, node->LocalRotation, node->LocalScale);
-                    }
-                    node->dirty = false;
-                } });
+            {
+                TSUBASA_PROFILE_SCOPE("TransformStore::Update");
+                TransformStore::Shared().Update(&jobs);
+            }
+            // Refit the bounds of moved renderers
+            spatial.Update(*this);
             // System->OnUpdate
-            for (const auto &system : systems)
             {
-                if (!system->OnUpdate(timeDelta))
+                TSUBASA_PROFILE_SCOPE("System::OnUpdate");
+                if (!updateSystems(timeDelta, false))
                 {
                     running = false;
                 }
             }
             // Application->OnUpdate
-            OnUpdate(timeDelta);
-            auto end = std::chrono::high_resolution_clock::now();
-            timeDelta = std::chrono::duration<float>(end - begin).count();
+            {
+                TSUBASA_PROFILE_SCOPE("Application::OnUpdate");
+                OnUpdate(timeDelta);
+            }
+            TSUBASA_PROFILE_FRAME_END();
+            if (MaxFrames > 0 && ++frames >= MaxFrames)
+            {
+                running = false;
+            }
+            timeDelta = Pacer.Wait();
         }
-        Root->Traverse([](const std::shared_ptr<Node> &node)
+        Root->Traverse([](Node &node)
                        {
-            for (const auto &component : node->Components)
+            for (const auto &component : node.Components)
             {
-                component->OnDestroy();
+                component->destroy();
             } });
         for (const auto &system : systems)
         {
@@ -105,4 +171,124 @@ namespace Tsubasa
     void Application::OnUpdate(float timeDelta) {}
 
     void Application::OnExit() {}
+
+    void Application::attachSystem(const std::shared_ptr<System> &system, const uint32_t &typeId)
+    {
+        system->application = this;
+        system->typeId = typeId;
+        systems.push_back(system);
+        scheduleValid = false;
+        if (typeId >= systemTable.size())
+        {
+            systemTable.resize(typeId + 1);
+        }
+        if (systemTable[typeId] == nullptr)
+        {
+            systemTable[typeId] = system;
+        }
+        if (running)
+        {
+            system->OnInit();
+        }
+    }
+
+    void Application::buildSchedule()
+    {
+        // A system goes one stage after the last earlier system it conflicts
+        // with, so conflicting systems keep their insertion order
+        std::vector<std::shared_ptr<System>> ordered(systems.begin(), systems.end());
+        std::vector<size_t> levels(ordered.size(), 0);
+        stages.clear();
+        for (size_t i = 0; i < ordered.size(); i++)
+        {
+            for (size_t j = 0; j < i; j++)
+            {
+                if (levels[j] + 1 > levels[i] && ordered[i]->ConflictsWith(*ordered[j]))
+                {
+                    levels[i] = levels[j] + 1;
+                }
+            }
+            if (levels[i] >= stages.size())
+            {
+                stages.resize(levels[i] + 1);
+            }
+            stages[levels[i]].push_back(ordered[i]);
+        }
+        scheduleValid = true;
+    }
+
+    bool Application::updateSystems(const float &timeDelta, const bool &fixed)
+    {
+        if (!scheduleValid)
+        {
+            buildSchedule();
+        }
+        auto update = [timeDelta, fixed](System &system)
+        {
+            TSUBASA_PROFILE_SCOPE(Profiler::TypeName(typeid(system)));
+            if (fixed)
+            {
+                system.OnFixedUpdate(timeDelta);
+                return true;
+            }
+            return system.OnUpdate(timeDelta);
+        };
+        std::atomic<bool> result(true);
+        for (const auto &stage : stages)
+        {
+            if (stage.size() == 1)
+            {
+                // Exclusive systems always end up alone in their stage
+                if (!update(*stage.front()))
+                {
+                    result = false;
+                }
+                continue;
+            }
+            JobCounter counter;
+            for (const auto &system : stage)
+            {
+                System *target = system.get();
+                jobs.Schedule([target, &update, &result]
+                              {
+                    if (!update(*target))
+                    {
+                        result = false;
+                    } }, &counter);
+            }
+            jobs.Wait(counter);
+        }
+        return result;
+    }
+
+    void Application::fixedUpdate(const float &timeDelta)
+    {
+        const float timeStep = 1.0f / FixedUpdateRate;
+        TransformStore &store = TransformStore::Shared();
+        accumulator += timeDelta;
+        unsigned int steps = 0;
+        while (accumulator >= timeStep && steps < MaxFixedSteps)
+        {
+            store.Update(&jobs);
+            store.BeginFixedStep();
+            {
+                TSUBASA_PROFILE_SCOPE("Component::OnFixedUpdate");
+                ComponentRegistry::Shared().FixedUpdate(this, timeStep);
+            }
+            if (!updateSystems(timeStep, true))
+            {
+                running = false;
+            }
+            store.Update(&jobs);
+            store.EndFixedStep();
+            accumulator -= timeStep;
+            steps++;
+        }
+        // Drop the time that could not be caught up with
+        if (accumulator >= timeStep)
+        {
+            accumulator = std::fmod(accumulator, timeStep);
+        }
+        interpolation = accumulator / timeStep;
+    }
 }
\ No newline at end of file
@@ -1,16 +1,25 @@
 #pragma once
 
+#include <Tsubasa/ComponentRegistry.h>
+#include <Tsubasa/FramePacer.h>
 #include <Tsubasa/Node.h>
 #include <Tsubasa/System.h>
 #include <Tsubasa/Components/Camera.h>
+#include <Tsubasa/Memory/Arena.h>
+#include <Tsubasa/Spatial/SpatialIndex.h>
+#include <Tsubasa/Threading/JobSystem.h>
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Tsubasa
 {
     class Application : public std::enable_shared_from_this<Application>
     {
+        friend class System;
+
     public:
         Application();
         ~Application();
@@ -21,18 +30,37 @@ namespace Tsubasa
         const std::shared_ptr<T> AddSystem(Args... args);
         bool HasSystem(const std::shared_ptr<System> &system) const;
         const std::shared_ptr<System> RemoveSystem(const std::shared_ptr<System> &system);
+        // Allocates the nodes and components added below Root from a scene
+        // arena from now on, so Unload() can free them in one shot
+        void UseArena(const size_t &blockSize = Arena::DefaultBlockSize);
+        const std::shared_ptr<Arena> &GetArena() const;
+        // Destroys every node below Root and releases the scene arena. Nodes
+        // still referenced elsewhere survive detached and keep the old arena
+        // alive until they are gone, the next scene gets a fresh one.
+        void Unload();
+        // Returns the first system added with exactly type T
         template <typename T>
         std::shared_ptr<T> GetSystem()
         {
-            for (auto &system : systems)
+            const uint32_t typeId = SystemTypeId::Of<T>();
+            if (typeId < systemTable.size())
             {
-                if (std::dynamic_pointer_cast<T>(system))
-                {
-                    return std::dynamic_pointer_cast<T>(system);
-                }
+                return std::static_pointer_cast<T>(systemTable[typeId]);
             }
             return nullptr;
         }
+        // Calls callback(Node &, T &, Others &...) for every node of this
+        // application owning all of the listed component types
+        template <typename T, typename... Others, typename Callback>
+        void Query(const Callback &callback)
+        {
+            ComponentRegistry::Shared().Query<T, Others...>([this, &callback](Node &entity, T &component, Others &...others)
+                                                            {
+                if (entity.Client == this)
+                {
+                    callback(entity, component, others...);
+                } });
+        }
         void Run();
 
         virtual void OnInit();
@@ -41,15 +69,49 @@ namespace Tsubasa
         virtual void OnExit();
 
         std::shared_ptr<Camera> ActiveCamera;
+        // Rate of OnFixedUpdate calls in Hz, 0 disables fixed steps
+        float FixedUpdateRate;
+        // Most fixed steps run in one frame before falling behind
+        unsigned int MaxFixedSteps;
+        // Frame rate limit and time delta clamping and smoothing of Run()
+        FramePacer Pacer;
+        // Run() returns after this many frames, 0 runs until a system stops it
+        uint64_t MaxFrames;
+        // Fraction of a fixed step left over this frame, for rendering with
+        // Node::GetInterpolatedTransform
+        const float &Interpolation;
 
         const std::shared_ptr<Node> &Root;
 
+        // World bounds of the renderers below Root, for culling, picking
+        // and proximity queries
+        SpatialIndex &Spatial;
+
         const std::list<std::shared_ptr<System>> &Systems;
 
+        JobSystem &Jobs;
+
     private:
         bool running;
+        float accumulator;
+        float interpolation;
+        // Shared with the allocator of every object drawn from it, so the
+        // arena outlives the scene whatever order members are destroyed in
+        std::shared_ptr<Arena> arena;
         std::shared_ptr<Node> root;
+        SpatialIndex spatial;
         std::list<std::shared_ptr<System>> systems;
+        std::vector<std::shared_ptr<System>> systemTable;
+        // Systems grouped into stages; the systems of one stage never
+        // conflict and run concurrently
+        std::vector<std::vector<std::shared_ptr<System>>> stages;
+        bool scheduleValid;
+        JobSystem jobs;
+
+        void attachSystem(const std::shared_ptr<System> &system, const uint32_t &typeId);
+        void buildSchedule();
+        bool updateSystems(const float &timeDelta, const bool &fixed);
+        void fixedUpdate(const float &timeDelta);
     };
 
     template <typename T>
@@ -58,26 +120,16 @@ namespace Tsubasa
         if (system == nullptr)
         {
             std::shared_ptr<T> newSystem = std::make_shared<T>();
-            newSystem->application = shared_from_this();
-            systems.push_back(newSystem);
-            if (running)
-            {
-                newSystem->OnInit();
-            }
+            attachSystem(newSystem, SystemTypeId::Of<T>());
             return newSystem;
         }
-        else if (system->Client != shared_from_this())
+        else if (system->Client != this)
         {
             if (system->Client != nullptr)
             {
                 system->Client->RemoveSystem(system);
             }
-            system->application = shared_from_this();
-            systems.push_back(system);
-            if (running)
-            {
-                system->OnInit();
-            }
+            attachSystem(system, SystemTypeId::Of<T>());
             return system;
         }
         else
@@ -90,12 +142,7 @@ namespace Tsubasa
     const std::shared_ptr<T> Application::AddSystem(Args... args)
     {
         std::shared_ptr<T> newSystem = std::make_shared<T>(args...);
-        newSystem->entity = shared_from_this();
-        systems.push_back(newSystem);
-        if (running)
-        {
-            newSystem->OnInit();
-        }
+        attachSystem(newSystem, SystemTypeId::Of<T>());
         return newSystem;
     }
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <Tsubasa/Component.h>
 #include <Tsubasa/Application.h>
+#include <Tsubasa/ComponentRegistry.h>
 #include <Tsubasa/Node.h>
 
 namespace Tsubasa
@@ -7,15 +8,28 @@ namespace Tsubasa
     Component::Component() : Enabled(enabled), Entity(entity)
     {
         enabled = true;
+        storage = nullptr;
+        storageIndex = 0;
+        typeId = 0;
+        destroyed = false;
+        handle = HandleTable<Component>::Shared().Allocate(this);
     }
 
-    Component::~Component() {}
+    Component::~Component()
+    {
+        if (storage != nullptr)
+        {
+            storage->Remove(this);
+        }
+        HandleTable<Component>::Shared().Release(handle);
+    }
 
     void Component::Enable()
     {
         if (!enabled)
         {
             enabled = true;
+            MarkChanged();
             OnEnable();
         }
     }
@@ -25,6 +39,7 @@ namespace Tsubasa
         if (enabled)
         {
             enabled = false;
+            MarkChanged();
             OnDisable();
         }
     }
@@ -49,5 +64,39 @@ namespace Tsubasa
 
     void Component::OnUpdate(float timeDelta) {}
 
+    void Component::OnFixedUpdate(float timeStep) {}
+
     void Component::OnDestroy() {}
+
+    void Component::MarkChanged()
+    {
+        if (storage != nullptr)
+        {
+            storage->Touch();
+        }
+    }
+
+    void Component::destroy()
+    {
+        if (!destroyed)
+        {
+            destroyed = true;
+            OnDestroy();
+        }
+    }
+
+    JobSystem *Component::GetJobSystem() const
+    {
+        Node *node = entity.Get();
+        if (node == nullptr || node->Client == nullptr)
+        {
+            return nullptr;
+        }
+        return &node->Client->Jobs;
+    }
+
+    ComponentHandle Component::GetHandle() const
+    {
+        return handle;
+    }
 }
\ No newline at end of file
@@ -1,14 +1,20 @@
 #pragma once
 
-#include <memory>
+#include <Tsubasa/Handle.h>
+#include <cstdint>
 
 namespace Tsubasa
 {
+    class Application;
     class Node;
+    class ComponentStorage;
+    class JobSystem;
 
     class Component
     {
+        friend class Application;
         friend class Node;
+        friend class ComponentStorage;
 
     public:
         Component();
@@ -22,13 +28,34 @@ namespace Tsubasa
         virtual void OnEnable();
         virtual void OnDisable();
         virtual void OnUpdate(float timeDelta);
+        virtual void OnFixedUpdate(float timeStep);
         virtual void OnDestroy();
 
+        // Job system of the owning application, or nullptr when detached
+        JobSystem *GetJobSystem() const;
+        ComponentHandle GetHandle() const;
+
         const bool &Enabled;
-        const std::shared_ptr<Node> &Entity;
+        // Owning node, the node keeps its components alive and not the
+        // other way round
+        const NodeHandle &Entity;
+
+    protected:
+        // Tells consumers watching the storage Revision that this component
+        // changed in a way they may care about
+        void MarkChanged();
 
     private:
         bool enabled;
-        std::shared_ptr<Node> entity;
+        NodeHandle entity;
+        ComponentHandle handle;
+        ComponentStorage *storage;
+        uint32_t storageIndex;
+        uint32_t typeId;
+        bool destroyed;
+
+        // Calls OnDestroy() the first time only, Application::Run() ending and
+        // the owning node going away both destroy the component
+        void destroy();
     };
 }
\ No newline at end of file
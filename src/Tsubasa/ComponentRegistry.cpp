@@ -0,0 +1,199 @@
+#include <Tsubasa/ComponentRegistry.h>
+#include <Tsubasa/Node.h>
+#include <Tsubasa/Profiling/Profiler.h>
+#include <stdexcept>
+
+namespace Tsubasa
+{
+    ComponentStorage::ComponentStorage() : Components(components), Entities(entities), Revision(revision)
+    {
+        revision = 0;
+        update = nullptr;
+        fixedUpdate = nullptr;
+        passes = 0;
+        holes = false;
+        virtualUpdate = false;
+        type = &typeid(Component);
+    }
+
+    ComponentStorage::~ComponentStorage() {}
+
+    void ComponentStorage::Add(Component *component, Node *entity)
+    {
+        component->storage = this;
+        component->storageIndex = static_cast<uint32_t>(components.size());
+        components.push_back(component);
+        entities.push_back(entity);
+        revision++;
+    }
+
+    void ComponentStorage::Remove(Component *component)
+    {
+        uint32_t index = component->storageIndex;
+        component->storage = nullptr;
+        revision++;
+        if (passes > 0)
+        {
+            components[index] = nullptr;
+            entities[index] = nullptr;
+            holes = true;
+            return;
+        }
+        // Swap with the last entry to keep the list dense
+        components[index] = components.back();
+        entities[index] = entities.back();
+        components[index]->storageIndex = index;
+        components.pop_back();
+        entities.pop_back();
+    }
+
+    void ComponentStorage::Touch()
+    {
+        revision++;
+    }
+
+    size_t ComponentStorage::Size() const
+    {
+        return components.size();
+    }
+
+    void ComponentStorage::Update(const Application *client, const float &timeDelta)
+    {
+        beginPass();
+        if (virtualUpdate)
+        {
+            updateVirtual(*this, client, timeDelta);
+        }
+        else if (update != nullptr)
+        {
+            update(*this, client, timeDelta);
+        }
+        endPass();
+    }
+
+    void ComponentStorage::FixedUpdate(const Application *client, const float &timeStep)
+    {
+        beginPass();
+        if (virtualUpdate)
+        {
+            fixedUpdateVirtual(*this, client, timeStep);
+        }
+        else if (fixedUpdate != nullptr)
+        {
+            fixedUpdate(*this, client, timeStep);
+        }
+        endPass();
+    }
+
+    void ComponentStorage::UseVirtualUpdate()
+    {
+        virtualUpdate = true;
+    }
+
+    bool ComponentStorage::active(const size_t &index, const Application *client) const
+    {
+        return components[index] != nullptr && components[index]->Enabled && entities[index]->Client == client;
+    }
+
+    void ComponentStorage::beginPass()
+    {
+        passes++;
+    }
+
+    void ComponentStorage::endPass()
+    {
+        if (--passes > 0 || !holes)
+        {
+            return;
+        }
+        size_t count = 0;
+        for (size_t i = 0; i < components.size(); i++)
+        {
+            if (components[i] != nullptr)
+            {
+                components[count] = components[i];
+                entities[count] = entities[i];
+                components[count]->storageIndex = static_cast<uint32_t>(count);
+                count++;
+            }
+        }
+        components.resize(count);
+        entities.resize(count);
+        holes = false;
+    }
+
+    void ComponentStorage::updateVirtual(const ComponentStorage &storage, const Application *client, const float &timeDelta)
+    {
+        for (size_t i = 0; i < storage.components.size(); i++)
+        {
+            if (storage.active(i, client))
+            {
+                storage.components[i]->OnUpdate(timeDelta);
+            }
+        }
+    }
+
+    void ComponentStorage::fixedUpdateVirtual(const ComponentStorage &storage, const Application *client, const float &timeStep)
+    {
+        for (size_t i = 0; i < storage.components.size(); i++)
+        {
+            if (storage.active(i, client))
+            {
+                storage.components[i]->OnFixedUpdate(timeStep);
+            }
+        }
+    }
+
+    ComponentRegistry::ComponentRegistry() {}
+
+    ComponentRegistry::~ComponentRegistry() {}
+
+    ComponentStorage &ComponentRegistry::Storage(const uint32_t &typeId)
+    {
+        if (typeId >= MaxComponentTypes)
+        {
+            throw std::runtime_error("Too many component types.");
+        }
+        if (typeId >= storages.size())
+        {
+            storages.resize(typeId + 1);
+        }
+        if (storages[typeId] == nullptr)
+        {
+            storages[typeId] = std::make_unique<ComponentStorage>();
+        }
+        return *storages[typeId];
+    }
+
+    void ComponentRegistry::Update(const Application *client, const float &timeDelta)
+    {
+        // Updates may register new component types
+        for (size_t i = 0; i < storages.size(); i++)
+        {
+            if (storages[i] != nullptr)
+            {
+                TSUBASA_PROFILE_SCOPE(Profiler::TypeName(*storages[i]->type));
+                storages[i]->Update(client, timeDelta);
+            }
+        }
+    }
+
+    void ComponentRegistry::FixedUpdate(const Application *client, const float &timeStep)
+    {
+        for (size_t i = 0; i < storages.size(); i++)
+        {
+            if (storages[i] != nullptr)
+            {
+                TSUBASA_PROFILE_SCOPE(Profiler::TypeName(*storages[i]->type));
+                storages[i]->FixedUpdate(client, timeStep);
+            }
+        }
+    }
+
+    ComponentRegistry &ComponentRegistry::Shared()
+    {
+        // Never destroyed, components may be released during static destruction
+        static ComponentRegistry *registry = new ComponentRegistry();
+        return *registry;
+    }
+}
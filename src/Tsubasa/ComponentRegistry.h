@@ -0,0 +1,243 @@
+#pragma once
+
+#include <Tsubasa/Component.h>
+#include <Tsubasa/Span.h>
+#include <Tsubasa/TypeId.h>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace Tsubasa
+{
+    class Application;
+    class Node;
+
+    using ComponentTypeId = TypeId<Component>;
+
+    constexpr uint32_t MaxComponentTypes = 128;
+
+    using ComponentMask = std::bitset<MaxComponentTypes>;
+
+    template <typename T>
+    T *FindComponent(Node *entity);
+
+    // Components may opt into batched updates with
+    // static void UpdateBatch(Span<T *const> components, float timeDelta)
+    template <typename T, typename = void>
+    struct HasUpdateBatch : std::false_type
+    {
+    };
+    template <typename T>
+    struct HasUpdateBatch<T, std::void_t<decltype(T::UpdateBatch(std::declval<Span<T *const>>(), 0.0f))>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    constexpr bool OverridesUpdate = !std::is_same_v<decltype(&T::OnUpdate), void (Component::*)(float)>;
+    template <typename T>
+    constexpr bool OverridesFixedUpdate = !std::is_same_v<decltype(&T::OnFixedUpdate), void (Component::*)(float)>;
+
+    // Dense list of every live component of one concrete type and its owner
+    class ComponentStorage
+    {
+        friend class ComponentRegistry;
+
+    public:
+        ComponentStorage();
+        ~ComponentStorage();
+
+        void Add(Component *component, Node *entity);
+        // During an update pass the entry is only cleared, and the list is
+        // compacted once the pass ends, so the pass never skips a component
+        void Remove(Component *component);
+        // Bumps Revision for changes that keep the component in the list
+        void Touch();
+        size_t Size() const;
+        // Updates the enabled components owned by client
+        void Update(const Application *client, const float &timeDelta);
+        void FixedUpdate(const Application *client, const float &timeStep);
+        // Falls back to virtual OnUpdate calls, for storages that also hold
+        // components of a more derived type than the one they were added as
+        void UseVirtualUpdate();
+
+        const std::vector<Component *> &Components;
+        const std::vector<Node *> &Entities;
+        // Changes whenever a component is added, removed, enabled, disabled
+        // or moved to another application, or touched otherwise, so that a
+        // consumer can skip rescanning an unchanged storage
+        const uint64_t &Revision;
+
+    private:
+        using UpdateFunction = void (*)(const ComponentStorage &storage, const Application *client, const float &timeDelta);
+
+        std::vector<Component *> components;
+        std::vector<Node *> entities;
+        // Scratch list of the batched update, a std::vector<T *>
+        std::shared_ptr<void> batch;
+        uint64_t revision;
+        uint32_t passes;
+        bool holes;
+        UpdateFunction update;
+        UpdateFunction fixedUpdate;
+        bool virtualUpdate;
+        const std::type_info *type;
+
+        bool active(const size_t &index, const Application *client) const;
+        void beginPass();
+        void endPass();
+        template <typename T>
+        static void updateBatch(const ComponentStorage &storage, const Application *client, const float &timeDelta);
+        template <typename T>
+        static void updateEach(const ComponentStorage &storage, const Application *client, const float &timeDelta);
+        template <typename T>
+        static void fixedUpdateEach(const ComponentStorage &storage, const Application *client, const float &timeStep);
+        static void updateVirtual(const ComponentStorage &storage, const Application *client, const float &timeDelta);
+        static void fixedUpdateVirtual(const ComponentStorage &storage, const Application *client, const float &timeStep);
+    };
+
+    // Components grouped by type, so systems can iterate one type at a time
+    // instead of walking the node tree. Structural changes (adding or removing
+    // components) must not happen while a query over the same type runs.
+    class ComponentRegistry
+    {
+    public:
+        ComponentRegistry();
+        ~ComponentRegistry();
+
+        ComponentStorage &Storage(const uint32_t &typeId);
+        template <typename T>
+        ComponentStorage &Storage();
+
+        // Calls callback(Node &, T &, Others &...) for every node owning all of
+        // the listed types. Iteration follows the storage of T, so the rarest
+        // type should come first.
+        template <typename T, typename... Others, typename Callback>
+        void Query(const Callback &callback);
+
+        // Updates the components of client one type at a time. Types that do
+        // not override OnUpdate are skipped.
+        void Update(const Application *client, const float &timeDelta);
+        void FixedUpdate(const Application *client, const float &timeStep);
+
+        static ComponentRegistry &Shared();
+
+    private:
+        std::vector<std::unique_ptr<ComponentStorage>> storages;
+    };
+}
+
+#include <Tsubasa/Node.h>
+
+namespace Tsubasa
+{
+    template <typename T>
+    void ComponentStorage::updateBatch(const ComponentStorage &storage, const Application *client, const float &timeDelta)
+    {
+        // Taken out of the storage for the call, so that a nested pass over
+        // the same type fills a list of its own
+        std::vector<T *> batch;
+        batch.swap(*static_cast<std::vector<T *> *>(storage.batch.get()));
+        batch.clear();
+        for (size_t i = 0; i < storage.components.size(); i++)
+        {
+            if (storage.active(i, client))
+            {
+                batch.push_back(static_cast<T *>(storage.components[i]));
+            }
+        }
+        if (!batch.empty())
+        {
+            T::UpdateBatch(Span<T *const>(batch.data(), batch.size()), timeDelta);
+        }
+        batch.swap(*static_cast<std::vector<T *> *>(storage.batch.get()));
+    }
+
+    template <typename T>
+    void ComponentStorage::updateEach(const ComponentStorage &storage, const Application *client, const float &timeDelta)
+    {
+        // Every component here is exactly a T, so the call needs no vtable
+        for (size_t i = 0; i < storage.components.size(); i++)
+        {
+            if (storage.active(i, client))
+            {
+                static_cast<T *>(storage.components[i])->T::OnUpdate(timeDelta);
+            }
+        }
+    }
+
+    template <typename T>
+    void ComponentStorage::fixedUpdateEach(const ComponentStorage &storage, const Application *client, const float &timeStep)
+    {
+        for (size_t i = 0; i < storage.components.size(); i++)
+        {
+            if (storage.active(i, client))
+            {
+                static_cast<T *>(storage.components[i])->T::OnFixedUpdate(timeStep);
+            }
+        }
+    }
+
+    template <typename T>
+    ComponentStorage &ComponentRegistry::Storage()
+    {
+        ComponentStorage &storage = Storage(ComponentTypeId::Of<T>());
+        storage.type = &typeid(T);
+        if constexpr (HasUpdateBatch<T>::value)
+        {
+            if (storage.batch == nullptr)
+            {
+                storage.batch = std::make_shared<std::vector<T *>>();
+            }
+            storage.update = &ComponentStorage::updateBatch<T>;
+        }
+        else if constexpr (OverridesUpdate<T>)
+        {
+            storage.update = &ComponentStorage::updateEach<T>;
+        }
+        if constexpr (OverridesFixedUpdate<T>)
+        {
+            storage.fixedUpdate = &ComponentStorage::fixedUpdateEach<T>;
+        }
+        return storage;
+    }
+
+    template <typename T, typename... Others, typename Callback>
+    void ComponentRegistry::Query(const Callback &callback)
+    {
+        const uint32_t typeId = ComponentTypeId::Of<T>();
+        if (typeId >= storages.size() || storages[typeId] == nullptr)
+        {
+            return;
+        }
+        const ComponentStorage &storage = *storages[typeId];
+        for (size_t i = 0; i < storage.components.size(); i++)
+        {
+            Node *entity = storage.entities[i];
+            T *component = static_cast<T *>(storage.components[i]);
+            if (component == nullptr)
+            {
+                continue;
+            }
+            if constexpr (sizeof...(Others) == 0)
+            {
+                callback(*entity, *component);
+            }
+            else
+            {
+                auto others = std::make_tuple(FindComponent<Others>(entity)...);
+                if (std::apply([](auto *...pointers)
+                               { return ((pointers != nullptr) && ...); },
+                               others))
+                {
+                    std::apply([&](auto *...pointers)
+                               { callback(*entity, *component, *pointers...); },
+                               others);
+                }
+            }
+        }
+    }
+}
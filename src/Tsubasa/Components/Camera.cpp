@@ -1,4 +1,7 @@
 #include <Tsubasa/Components/Camera.h>
+#include <Tsubasa/Node.h>
+#include <algorithm>
+#include <math.h>
 
 namespace Tsubasa
 {
@@ -6,7 +9,28 @@ namespace Tsubasa
     {
         Projection = projection;
         FieldOfView = fieldOfView;
+        NearPlane = 0.01f;
+        FarPlane = 1000.0f;
     }
     
     Camera::~Camera() {}
+
+    Frustum Camera::GetFrustum(const float &aspect) const
+    {
+        const Affine3x4 transform = Entity->GetTransform();
+        if (Projection == CameraProjection::Orthographic)
+        {
+            return Frustum::Orthographic(transform, FieldOfView * 0.5f, aspect, NearPlane, FarPlane);
+        }
+        return Frustum::Perspective(transform, FieldOfView * 3.14159265359f / 180.0f, aspect, NearPlane, FarPlane);
+    }
+
+    float Camera::GetScreenSize(const float &depth, const float &radius) const
+    {
+        if (Projection == CameraProjection::Orthographic)
+        {
+            return radius / (FieldOfView * 0.5f);
+        }
+        return radius / (std::max(depth, NearPlane) * tanf(FieldOfView * 3.14159265359f / 360.0f));
+    }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Tsubasa/Component.h>
+#include <Tsubasa/Math/Frustum.h>
 
 namespace Tsubasa
 {
@@ -16,7 +17,17 @@ namespace Tsubasa
         Camera(float fieldOfView = 45.0f, CameraProjection projection = CameraProjection::Perspective);
         ~Camera();
 
+        // View volume in world space for a viewport of the given aspect
+        // ratio, the camera must be attached to a node
+        Frustum GetFrustum(const float &aspect) const;
+        // Fraction of the viewport height covered by a sphere whose center
+        // lies depth in front of the camera
+        float GetScreenSize(const float &depth, const float &radius) const;
+
         float FieldOfView;
         CameraProjection Projection;
+        // Distances of the clip planes along the view direction
+        float NearPlane;
+        float FarPlane;
     };
 }
\ No newline at end of file
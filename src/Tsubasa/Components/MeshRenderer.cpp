@@ -1,11 +1,14 @@
 #include <Tsubasa/Components/MeshRenderer.h>
 #include <Tsubasa/Node.h>
 #include <raylib/raylib.h>
+#include <algorithm>
 
 namespace Tsubasa
 {
     MeshRenderer::MeshRenderer(std::shared_ptr<Model> model)
     {
+        Hysteresis = 0.1f;
+        Transparent = false;
         if (model != nullptr)
         {
             RenderModel = model;
@@ -17,4 +20,53 @@ namespace Tsubasa
     }
 
     MeshRenderer::~MeshRenderer() {}
+
+    void MeshRenderer::SetModel(const std::shared_ptr<Model> &model)
+    {
+        RenderModel = model;
+        MarkChanged();
+    }
+
+    size_t MeshRenderer::SelectLevel(const float &screenSize, const size_t &current) const
+    {
+        // Level i + 1 starts below the threshold of Levels[i]
+        size_t level = std::min(current, Levels.size());
+        while (level < Levels.size() && screenSize < Levels[level].ScreenSize)
+        {
+            level++;
+        }
+        while (level > 0 && screenSize > Levels[level - 1].ScreenSize * (1.0f + Hysteresis))
+        {
+            level--;
+        }
+        return level;
+    }
+
+    const Model *MeshRenderer::GetLevelModel(const size_t &level) const
+    {
+        if (level == 0 || level > Levels.size() || Levels[level - 1].RenderModel == nullptr)
+        {
+            return RenderModel.get();
+        }
+        return Levels[level - 1].RenderModel.get();
+    }
+
+    std::vector<MeshRenderer::LevelOfDetail> MeshRenderer::PrimitiveLevels(const MeshType &type, const size_t &count, const int &detail, const float &screenSize)
+    {
+        std::vector<LevelOfDetail> levels;
+        if (type != MeshType::Sphere)
+        {
+            return levels;
+        }
+        // Fewer than four rings and slices no longer look like a sphere
+        int levelDetail = detail;
+        float threshold = screenSize;
+        for (size_t i = 0; i < count && levelDetail / 2 >= 4; i++)
+        {
+            levelDetail /= 2;
+            levels.push_back({Model::FromPrimitive(type, levelDetail), threshold});
+            threshold *= 0.25f;
+        }
+        return levels;
+    }
 }
\ No newline at end of file
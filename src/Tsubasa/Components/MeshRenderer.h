@@ -2,16 +2,51 @@
 
 #include <Tsubasa/Component.h>
 #include <Tsubasa/Rendering/Model.h>
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 namespace Tsubasa
 {
+    // Levels of detail are chosen per frame by the screen size, the
+    // fraction of the viewport height the renderer's bounds cover.
+    // RenderModel is level 0, and Levels lists coarser stand-ins by
+    // decreasing ScreenSize. A level takes over below its threshold, and
+    // the finer one only returns above the threshold raised by Hysteresis,
+    // so renderers hovering around a threshold do not pop back and forth.
+    // That needs the level picked last time, which every view keeps on its
+    // own, see CullingStage.
     class MeshRenderer : public Component
     {
     public:
+        struct LevelOfDetail
+        {
+            std::shared_ptr<Model> RenderModel;
+            float ScreenSize;
+        };
+
         MeshRenderer(std::shared_ptr<Model> model = nullptr);
         ~MeshRenderer();
 
+        // Replaces RenderModel and lets the spatial index know its bounds
+        // changed, assigning RenderModel directly is only noticed once the
+        // renderer moves
+        void SetModel(const std::shared_ptr<Model> &model);
+        // Level for the given screen size, coming from the current one
+        size_t SelectLevel(const float &screenSize, const size_t &current) const;
+        // Model of a level, 0 for RenderModel
+        const Model *GetLevelModel(const size_t &level) const;
+
+        // Coarser tessellations of a primitive, with detail halved and the
+        // screen size quartered from one level to the next. Only spheres
+        // have any, the result is meant to be shared between renderers.
+        static std::vector<LevelOfDetail> PrimitiveLevels(const MeshType &type, const size_t &count = 2, const int &detail = Model::DefaultDetail, const float &screenSize = 0.25f);
+
         std::shared_ptr<Model> RenderModel;
+        std::vector<LevelOfDetail> Levels;
+        // Relative margin above a threshold before switching back
+        float Hysteresis;
+        // Drawn after the opaque renderers, back to front and without depth writes
+        bool Transparent;
     };
 }
\ No newline at end of file
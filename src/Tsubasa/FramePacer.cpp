@@ -0,0 +1,78 @@
+#include <Tsubasa/FramePacer.h>
+#include <algorithm>
+#include <thread>
+
+namespace Tsubasa
+{
+    FramePacer::FramePacer() : RawTimeDelta(rawTimeDelta)
+    {
+        TargetFrameRate = 0.0f;
+        SpinTime = 0.002f;
+        MaxTimeDelta = 0.25f;
+        Smoothing = 0.0f;
+        Reset();
+    }
+
+    FramePacer::~FramePacer() {}
+
+    void FramePacer::Reset()
+    {
+        last = Clock::now();
+        deadline = last;
+        rawTimeDelta = 0.0f;
+        timeDelta = 0.0f;
+        first = true;
+    }
+
+    float FramePacer::Wait()
+    {
+        if (TargetFrameRate > 0.0f)
+        {
+            const auto frameTime = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(1.0f / TargetFrameRate));
+            deadline += frameTime;
+            const Clock::time_point now = Clock::now();
+            if (now - deadline > frameTime)
+            {
+                deadline = now;
+            }
+            else
+            {
+                waitUntil(deadline);
+            }
+        }
+        const Clock::time_point now = Clock::now();
+        rawTimeDelta = std::chrono::duration<float>(now - last).count();
+        last = now;
+
+        float delta = MaxTimeDelta > 0.0f ? std::min(rawTimeDelta, MaxTimeDelta) : rawTimeDelta;
+        if (!first)
+        {
+            const float smoothing = std::clamp(Smoothing, 0.0f, 0.99f);
+            delta = timeDelta * smoothing + delta * (1.0f - smoothing);
+        }
+        timeDelta = delta;
+        first = false;
+        return timeDelta;
+    }
+
+    void FramePacer::waitUntil(const Clock::time_point &time) const
+    {
+        const auto spin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(SpinTime));
+        while (true)
+        {
+            const auto remaining = time - Clock::now();
+            if (remaining <= Clock::duration::zero())
+            {
+                return;
+            }
+            if (remaining > spin)
+            {
+                std::this_thread::sleep_for(remaining - spin);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
\ No newline at end of file
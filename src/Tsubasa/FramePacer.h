@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+
+namespace Tsubasa
+{
+    // Paces a frame loop to a target rate and produces its time deltas.
+    // Waiting sleeps until shortly before the deadline and spins for the
+    // rest, since sleeps can overshoot by a scheduler tick. Deadlines advance
+    // by whole frames so the rate does not drift, but a loop that falls more
+    // than a frame behind restarts from now instead of rushing to catch up.
+    class FramePacer
+    {
+    public:
+        FramePacer();
+        ~FramePacer();
+
+        // Starts timing from now, call before the first frame
+        void Reset();
+        // Waits for the end of the frame and returns the time delta since
+        // the previous call, clamped and smoothed
+        float Wait();
+
+        // Frames per second to pace to, 0 runs as fast as possible. Leave it
+        // at 0 when a VSync window already paces frames.
+        float TargetFrameRate;
+        // Seconds before the deadline at which sleeping turns into spinning
+        float SpinTime;
+        // Longest time delta returned, so a stall does not become one huge
+        // step. 0 disables the clamp.
+        float MaxTimeDelta;
+        // Weight of the previous deltas in the returned one, from 0 for the
+        // raw frame time up to just below 1
+        float Smoothing;
+
+        // Unclamped, unsmoothed duration of the last frame
+        const float &RawTimeDelta;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        Clock::time_point last;
+        Clock::time_point deadline;
+        float rawTimeDelta;
+        float timeDelta;
+        bool first;
+
+        void waitUntil(const Clock::time_point &time) const;
+    };
+}
\ No newline at end of file
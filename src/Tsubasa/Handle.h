@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Tsubasa
+{
+    template <typename T>
+    class HandleTable;
+
+    // Non-owning reference to an object registered in HandleTable<T>. It
+    // resolves to nullptr once the object is destroyed, even after its slot
+    // has been reused, and copying it touches no reference count.
+    template <typename T>
+    class Handle
+    {
+        friend class HandleTable<T>;
+
+    public:
+        Handle() : index(Invalid), generation(0) {}
+        Handle(std::nullptr_t) : Handle() {}
+
+        T *Get() const
+        {
+            return HandleTable<T>::Shared().Resolve(index, generation);
+        }
+        T *operator->() const
+        {
+            return Get();
+        }
+        T &operator*() const
+        {
+            return *Get();
+        }
+        explicit operator bool() const
+        {
+            return Get() != nullptr;
+        }
+        // Handles compare by identity, against nullptr by whether they resolve
+        bool operator==(const Handle &other) const
+        {
+            return index == other.index && generation == other.generation;
+        }
+        bool operator!=(const Handle &other) const
+        {
+            return !(*this == other);
+        }
+        bool operator==(std::nullptr_t) const
+        {
+            return Get() == nullptr;
+        }
+        bool operator!=(std::nullptr_t) const
+        {
+            return Get() != nullptr;
+        }
+
+        static constexpr uint32_t Invalid = UINT32_MAX;
+
+    private:
+        uint32_t index;
+        uint32_t generation;
+
+        Handle(const uint32_t &index, const uint32_t &generation) : index(index), generation(generation) {}
+    };
+
+    // Slots of every live object of type T. Releasing a slot bumps its
+    // generation, which invalidates all handles issued for it. Objects are
+    // registered and released on the main thread only.
+    template <typename T>
+    class HandleTable
+    {
+    public:
+        Handle<T> Allocate(T *object)
+        {
+            uint32_t index;
+            if (!freeSlots.empty())
+            {
+                index = freeSlots.back();
+                freeSlots.pop_back();
+            }
+            else
+            {
+                index = static_cast<uint32_t>(slots.size());
+                slots.push_back({nullptr, 0});
+            }
+            slots[index].Object = object;
+            return Handle<T>(index, slots[index].Generation);
+        }
+
+        void Release(const Handle<T> &handle)
+        {
+            if (Resolve(handle.index, handle.generation) != nullptr)
+            {
+                slots[handle.index].Object = nullptr;
+                slots[handle.index].Generation++;
+                freeSlots.push_back(handle.index);
+            }
+        }
+
+        T *Resolve(const uint32_t &index, const uint32_t &generation) const
+        {
+            if (index < slots.size() && slots[index].Generation == generation)
+            {
+                return slots[index].Object;
+            }
+            return nullptr;
+        }
+
+        static HandleTable &Shared()
+        {
+            // Never destroyed, objects may be released during static destruction
+            static HandleTable *table = new HandleTable();
+            return *table;
+        }
+
+    private:
+        struct Slot
+        {
+            T *Object;
+            uint32_t Generation;
+        };
+
+        std::vector<Slot> slots;
+        std::vector<uint32_t> freeSlots;
+    };
+
+    class Node;
+    class Component;
+
+    using NodeHandle = Handle<Node>;
+    using ComponentHandle = Handle<Component>;
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <Tsubasa/Math/Matrix4x4.h>
+#include <Tsubasa/Math/Quaternion.h>
+#include <Tsubasa/Math/Simd.h>
+#include <Tsubasa/Math/Vector3.h>
+#include <type_traits>
+
+namespace Tsubasa
+{
+    // Affine transform without the constant projective part of a Matrix4x4.
+    // Stored as three rows of four, row r gives output component r of a
+    // transformed point and ends with the translation. The first row holds
+    // Matrix4x4 elements m[0], m[4], m[8], m[12], and so on. Products compose
+    // in the same order as Matrix4x4, a * b applies a first.
+    class Affine3x4
+    {
+    public:
+        Affine3x4() = default;
+        constexpr Affine3x4(float m0, float m1, float m2, float m3, float m4, float m5, float m6, float m7, float m8, float m9, float m10, float m11)
+            : m{m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11} {}
+        explicit constexpr Affine3x4(const Matrix4x4 &matrix)
+            : m{matrix.m[0], matrix.m[4], matrix.m[8], matrix.m[12],
+                matrix.m[1], matrix.m[5], matrix.m[9], matrix.m[13],
+                matrix.m[2], matrix.m[6], matrix.m[10], matrix.m[14]} {}
+
+        constexpr Vector3 GetTranslation() const;
+        constexpr Affine3x4 Inversed() const;
+        constexpr Matrix4x4 Matrix() const;
+
+        static constexpr Affine3x4 Inverse(const Affine3x4 &transform);
+        static constexpr Affine3x4 TRS(const Vector3 &position, const Quaternion &rotation, const Vector3 &scale);
+
+        static const Affine3x4 Identity;
+
+        Affine3x4 operator*(const Affine3x4 &other) const;
+        Affine3x4 operator*=(const Affine3x4 &other);
+        constexpr Vector3 operator*(const Vector3 &point) const;
+
+        alignas(16) float m[12];
+    };
+
+    inline constexpr Affine3x4 Affine3x4::Identity = Affine3x4(1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f);
+
+    constexpr Vector3 Affine3x4::GetTranslation() const
+    {
+        return Vector3(m[3], m[7], m[11]);
+    }
+
+    constexpr Affine3x4 Affine3x4::Inversed() const
+    {
+        // Rows of the inverse linear part are the cross products of its
+        // columns over the determinant, the translation is then moved back
+        const Vector3 a(m[0], m[1], m[2]);
+        const Vector3 b(m[4], m[5], m[6]);
+        const Vector3 c(m[8], m[9], m[10]);
+        const Vector3 bc = b.Cross(c);
+        const Vector3 ca = c.Cross(a);
+        const Vector3 ab = a.Cross(b);
+        const float invDet = 1.0f / a.Dot(bc);
+        const Vector3 row0 = Vector3(bc.x, ca.x, ab.x) * invDet;
+        const Vector3 row1 = Vector3(bc.y, ca.y, ab.y) * invDet;
+        const Vector3 row2 = Vector3(bc.z, ca.z, ab.z) * invDet;
+        const Vector3 translation(m[3], m[7], m[11]);
+        return Affine3x4(row0.x, row0.y, row0.z, -row0.Dot(translation),
+                         row1.x, row1.y, row1.z, -row1.Dot(translation),
+                         row2.x, row2.y, row2.z, -row2.Dot(translation));
+    }
+
+    constexpr Matrix4x4 Affine3x4::Matrix() const
+    {
+        return Matrix4x4(m[0], m[4], m[8], 0.0f,
+                         m[1], m[5], m[9], 0.0f,
+                         m[2], m[6], m[10], 0.0f,
+                         m[3], m[7], m[11], 1.0f);
+    }
+
+    constexpr Affine3x4 Affine3x4::Inverse(const Affine3x4 &transform)
+    {
+        return transform.Inversed();
+    }
+
+    constexpr Affine3x4 Affine3x4::TRS(const Vector3 &position, const Quaternion &rotation, const Vector3 &scale)
+    {
+        const float xx = rotation.x * rotation.x, yy = rotation.y * rotation.y, zz = rotation.z * rotation.z;
+        const float xy = rotation.x * rotation.y, xz = rotation.x * rotation.z, yz = rotation.y * rotation.z;
+        const float xw = rotation.x * rotation.w, yw = rotation.y * rotation.w, zw = rotation.z * rotation.w;
+        return Affine3x4((1.0f - 2.0f * (yy + zz)) * scale.x, 2.0f * (xy - zw) * scale.y, 2.0f * (xz + yw) * scale.z, position.x,
+                         2.0f * (xy + zw) * scale.x, (1.0f - 2.0f * (xx + zz)) * scale.y, 2.0f * (yz - xw) * scale.z, position.y,
+                         2.0f * (xz - yw) * scale.x, 2.0f * (yz + xw) * scale.y, (1.0f - 2.0f * (xx + yy)) * scale.z, position.z);
+    }
+
+    inline Affine3x4 Affine3x4::operator*(const Affine3x4 &other) const
+    {
+        Affine3x4 result;
+#if defined(TSUBASA_SSE)
+        Simd::MultiplyAffine(m, other.m, result.m);
+#else
+        // Row r of the result is other's row r applied to this transform
+        for (int row = 0; row < 12; row += 4)
+        {
+            const float *b = other.m + row;
+            result.m[row] = b[0] * m[0] + b[1] * m[4] + b[2] * m[8];
+            result.m[row + 1] = b[0] * m[1] + b[1] * m[5] + b[2] * m[9];
+            result.m[row + 2] = b[0] * m[2] + b[1] * m[6] + b[2] * m[10];
+            result.m[row + 3] = b[0] * m[3] + b[1] * m[7] + b[2] * m[11] + b[3];
+        }
+#endif
+        return result;
+    }
+
+    inline Affine3x4 Affine3x4::operator*=(const Affine3x4 &other)
+    {
+        *this = *this * other;
+        return *this;
+    }
+
+    constexpr Vector3 Affine3x4::operator*(const Vector3 &point) const
+    {
+        return Vector3(m[0] * point.x + m[1] * point.y + m[2] * point.z + m[3],
+                       m[4] * point.x + m[5] * point.y + m[6] * point.z + m[7],
+                       m[8] * point.x + m[9] * point.y + m[10] * point.z + m[11]);
+    }
+
+    static_assert(std::is_trivially_copyable_v<Affine3x4>);
+}
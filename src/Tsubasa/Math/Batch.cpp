@@ -0,0 +1,296 @@
+#include <Tsubasa/Math/Batch.h>
+#include <Tsubasa/Math/Simd.h>
+#include <algorithm>
+#include <math.h>
+#include <stdexcept>
+
+namespace Tsubasa
+{
+    namespace
+    {
+        void checkSizes(const size_t &a, const size_t &b)
+        {
+            if (a != b)
+            {
+                throw std::runtime_error("Batch spans differ in size.");
+            }
+        }
+
+#if defined(TSUBASA_SSE)
+        // Blend weights of Quaternion::Slerp for two unit quaternions whose
+        // dot product is `cosine`, returns true when the result is an nlerp
+        // that still needs to be normalized
+        bool slerpWeights(float cosine, const float &t, float &weightA, float &weightB)
+        {
+            const float epsilon = 0.000001f;
+            const float sign = cosine < 0 ? -1.0f : 1.0f;
+            cosine *= sign;
+            if (cosine >= 1.0f)
+            {
+                weightA = 1.0f;
+                weightB = 0.0f;
+                return false;
+            }
+            if (cosine > 0.95f)
+            {
+                weightA = 1.0f - t;
+                weightB = t * sign;
+                return true;
+            }
+            float halfTheta = acosf(cosine);
+            float sinHalfTheta = sqrtf(1.0f - cosine * cosine);
+            if (fabsf(sinHalfTheta) < epsilon)
+            {
+                weightA = 0.5f;
+                weightB = 0.5f * sign;
+            }
+            else
+            {
+                weightA = sinf((1 - t) * halfTheta) / sinHalfTheta;
+                weightB = sinf(t * halfTheta) / sinHalfTheta * sign;
+            }
+            return false;
+        }
+
+        // Three registers of packed (x, y, z) triples into one register per component
+        void loadVectors(const Vector3 *vectors, __m128 &x, __m128 &y, __m128 &z)
+        {
+            const float *data = &vectors->x;
+            const __m128 a = _mm_loadu_ps(data);
+            const __m128 b = _mm_loadu_ps(data + 4);
+            const __m128 c = _mm_loadu_ps(data + 8);
+            x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 3, 2)), _MM_SHUFFLE(3, 0, 3, 0));
+            y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+            z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+        }
+
+        void storeVectors(Vector3 *vectors, const __m128 &x, const __m128 &y, const __m128 &z)
+        {
+            float *data = &vectors->x;
+            _mm_storeu_ps(data, _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(data + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(data + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+        }
+
+        void loadQuaternions(const Quaternion *quaternions, __m128 &x, __m128 &y, __m128 &z, __m128 &w)
+        {
+            x = _mm_load_ps(&quaternions[0].x);
+            y = _mm_load_ps(&quaternions[1].x);
+            z = _mm_load_ps(&quaternions[2].x);
+            w = _mm_load_ps(&quaternions[3].x);
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+        }
+
+        // Rotation-scale terms of four TRS transforms, Rows[i][j] holds
+        // Matrix4x4 element m[i * 4 + j] of every lane
+        struct TRSLanes
+        {
+            __m128 Rows[3][3];
+            __m128 Position[3];
+        };
+
+        TRSLanes trs4(const Vector3 *positions, const Quaternion *rotations, const Vector3 *scales)
+        {
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 two = _mm_set1_ps(2.0f);
+            TRSLanes lanes;
+            __m128 sx, sy, sz, qx, qy, qz, qw;
+            loadVectors(positions, lanes.Position[0], lanes.Position[1], lanes.Position[2]);
+            loadVectors(scales, sx, sy, sz);
+            loadQuaternions(rotations, qx, qy, qz, qw);
+
+            const __m128 xx = _mm_mul_ps(qx, qx), yy = _mm_mul_ps(qy, qy), zz = _mm_mul_ps(qz, qz);
+            const __m128 xy = _mm_mul_ps(qx, qy), xz = _mm_mul_ps(qx, qz), yz = _mm_mul_ps(qy, qz);
+            const __m128 xw = _mm_mul_ps(qx, qw), yw = _mm_mul_ps(qy, qw), zw = _mm_mul_ps(qz, qw);
+
+            lanes.Rows[0][0] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx);
+            lanes.Rows[0][1] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, zw)), sx);
+            lanes.Rows[0][2] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, yw)), sx);
+            lanes.Rows[1][0] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, zw)), sy);
+            lanes.Rows[1][1] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy);
+            lanes.Rows[1][2] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, xw)), sy);
+            lanes.Rows[2][0] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, yw)), sz);
+            lanes.Rows[2][1] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, xw)), sz);
+            lanes.Rows[2][2] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz);
+            return lanes;
+        }
+
+        // Transposes four lanes into one 16-byte row of each of four outputs
+        template <typename T>
+        void storeRows(T *result, const int &offset, __m128 a, __m128 b, __m128 c, __m128 d)
+        {
+            _MM_TRANSPOSE4_PS(a, b, c, d);
+            _mm_store_ps(result[0].m + offset, a);
+            _mm_store_ps(result[1].m + offset, b);
+            _mm_store_ps(result[2].m + offset, c);
+            _mm_store_ps(result[3].m + offset, d);
+        }
+
+        void store(const TRSLanes &lanes, Matrix4x4 *result)
+        {
+            for (int row = 0; row < 3; row++)
+            {
+                storeRows(result, row * 4, lanes.Rows[row][0], lanes.Rows[row][1], lanes.Rows[row][2], _mm_setzero_ps());
+            }
+            storeRows(result, 12, lanes.Position[0], lanes.Position[1], lanes.Position[2], _mm_set1_ps(1.0f));
+        }
+
+        void store(const TRSLanes &lanes, Affine3x4 *result)
+        {
+            for (int row = 0; row < 3; row++)
+            {
+                storeRows(result, row * 4, lanes.Rows[0][row], lanes.Rows[1][row], lanes.Rows[2][row], lanes.Position[row]);
+            }
+        }
+#endif
+
+        template <typename T>
+        void trsBatch(Span<const Vector3> positions, Span<const Quaternion> rotations, Span<const Vector3> scales, Span<T> result)
+        {
+            const size_t count = result.Size();
+            checkSizes(positions.Size(), count);
+            checkSizes(rotations.Size(), count);
+            checkSizes(scales.Size(), count);
+#if defined(TSUBASA_SSE)
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                store(trs4(&positions[i], &rotations[i], &scales[i]), &result[i]);
+            }
+            if (i < count)
+            {
+                // Pad the remainder so every element goes through the same kernel
+                Vector3 paddedPositions[4] = {Vector3::Zero, Vector3::Zero, Vector3::Zero, Vector3::Zero};
+                Quaternion paddedRotations[4] = {Quaternion::Identity, Quaternion::Identity, Quaternion::Identity, Quaternion::Identity};
+                Vector3 paddedScales[4] = {Vector3::One, Vector3::One, Vector3::One, Vector3::One};
+                T paddedResult[4];
+                std::copy(positions.begin() + i, positions.end(), paddedPositions);
+                std::copy(rotations.begin() + i, rotations.end(), paddedRotations);
+                std::copy(scales.begin() + i, scales.end(), paddedScales);
+                store(trs4(paddedPositions, paddedRotations, paddedScales), paddedResult);
+                std::copy(paddedResult, paddedResult + (count - i), result.begin() + i);
+            }
+#else
+            for (size_t i = 0; i < count; i++)
+            {
+                result[i] = T::TRS(positions[i], rotations[i], scales[i]);
+            }
+#endif
+        }
+
+        template <typename T>
+        void multiplyBatch(Span<const T> a, Span<const T> b, Span<T> result)
+        {
+            const size_t count = result.Size();
+            checkSizes(a.Size(), count);
+            checkSizes(b.Size(), count);
+            // A single product already fills the registers, so this runs one
+            // product at a time through the SIMD multiply
+            for (size_t i = 0; i < count; i++)
+            {
+                result[i] = a[i] * b[i];
+            }
+        }
+    }
+
+    void TRSBatch(Span<const Vector3> positions, Span<const Quaternion> rotations, Span<const Vector3> scales, Span<Matrix4x4> result)
+    {
+        trsBatch(positions, rotations, scales, result);
+    }
+
+    void TRSBatch(Span<const Vector3> positions, Span<const Quaternion> rotations, Span<const Vector3> scales, Span<Affine3x4> result)
+    {
+        trsBatch(positions, rotations, scales, result);
+    }
+
+    void MultiplyBatch(Span<const Matrix4x4> a, Span<const Matrix4x4> b, Span<Matrix4x4> result)
+    {
+        multiplyBatch(a, b, result);
+    }
+
+    void MultiplyBatch(Span<const Affine3x4> a, Span<const Affine3x4> b, Span<Affine3x4> result)
+    {
+        multiplyBatch(a, b, result);
+    }
+
+    void TransformPoints(const Matrix4x4 &matrix, Span<const Vector3> points, Span<Vector3> result)
+    {
+        const size_t count = result.Size();
+        checkSizes(points.Size(), count);
+        size_t i = 0;
+#if defined(TSUBASA_SSE)
+        const float *m = matrix.m;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 x, y, z;
+            loadVectors(&points[i], x, y, z);
+            __m128 rx = Simd::MultiplyAdd(_mm_set1_ps(m[0]), x, Simd::MultiplyAdd(_mm_set1_ps(m[4]), y, Simd::MultiplyAdd(_mm_set1_ps(m[8]), z, _mm_set1_ps(m[12]))));
+            __m128 ry = Simd::MultiplyAdd(_mm_set1_ps(m[1]), x, Simd::MultiplyAdd(_mm_set1_ps(m[5]), y, Simd::MultiplyAdd(_mm_set1_ps(m[9]), z, _mm_set1_ps(m[13]))));
+            __m128 rz = Simd::MultiplyAdd(_mm_set1_ps(m[2]), x, Simd::MultiplyAdd(_mm_set1_ps(m[6]), y, Simd::MultiplyAdd(_mm_set1_ps(m[10]), z, _mm_set1_ps(m[14]))));
+            storeVectors(&result[i], rx, ry, rz);
+        }
+#endif
+        for (; i < count; i++)
+        {
+            result[i] = matrix * points[i];
+        }
+    }
+
+    void QuaternionSlerpBatch(Span<const Quaternion> a, Span<const Quaternion> b, const float &t, Span<Quaternion> result)
+    {
+        const size_t count = result.Size();
+        checkSizes(a.Size(), count);
+        checkSizes(b.Size(), count);
+        size_t i = 0;
+#if defined(TSUBASA_SSE)
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 ax, ay, az, aw, bx, by, bz, bw;
+            loadQuaternions(&a[i], ax, ay, az, aw);
+            loadQuaternions(&b[i], bx, by, bz, bw);
+            __m128 dot = _mm_mul_ps(ax, bx);
+            dot = Simd::MultiplyAdd(ay, by, dot);
+            dot = Simd::MultiplyAdd(az, bz, dot);
+            dot = Simd::MultiplyAdd(aw, bw, dot);
+
+            // The trigonometry stays scalar, one call per lane
+            alignas(16) float cosines[4], weightsA[4], weightsB[4], normalize[4];
+            _mm_store_ps(cosines, dot);
+            for (int lane = 0; lane < 4; lane++)
+            {
+                normalize[lane] = slerpWeights(cosines[lane], t, weightsA[lane], weightsB[lane]) ? 1.0f : 0.0f;
+            }
+            const __m128 weightA = _mm_load_ps(weightsA);
+            const __m128 weightB = _mm_load_ps(weightsB);
+            __m128 rx = Simd::MultiplyAdd(ax, weightA, _mm_mul_ps(bx, weightB));
+            __m128 ry = Simd::MultiplyAdd(ay, weightA, _mm_mul_ps(by, weightB));
+            __m128 rz = Simd::MultiplyAdd(az, weightA, _mm_mul_ps(bz, weightB));
+            __m128 rw = Simd::MultiplyAdd(aw, weightA, _mm_mul_ps(bw, weightB));
+
+            // Normalize the nlerp lanes, leaving the others untouched
+            __m128 length = _mm_mul_ps(rx, rx);
+            length = Simd::MultiplyAdd(ry, ry, length);
+            length = Simd::MultiplyAdd(rz, rz, length);
+            length = Simd::MultiplyAdd(rw, rw, length);
+            length = _mm_sqrt_ps(length);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 mask = _mm_andnot_ps(_mm_cmpeq_ps(length, zero), _mm_cmpneq_ps(_mm_load_ps(normalize), zero));
+            const __m128 scale = _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(_mm_set1_ps(1.0f), length)), _mm_andnot_ps(mask, _mm_set1_ps(1.0f)));
+            rx = _mm_mul_ps(rx, scale);
+            ry = _mm_mul_ps(ry, scale);
+            rz = _mm_mul_ps(rz, scale);
+            rw = _mm_mul_ps(rw, scale);
+
+            _MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+            _mm_store_ps(&result[i].x, rx);
+            _mm_store_ps(&result[i + 1].x, ry);
+            _mm_store_ps(&result[i + 2].x, rz);
+            _mm_store_ps(&result[i + 3].x, rw);
+        }
+#endif
+        for (; i < count; i++)
+        {
+            result[i] = Quaternion::Slerp(a[i], b[i], t);
+        }
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Tsubasa/Math/Affine3x4.h>
+#include <Tsubasa/Math/Matrix4x4.h>
+#include <Tsubasa/Math/Quaternion.h>
+#include <Tsubasa/Math/Vector3.h>
+#include <Tsubasa/Span.h>
+
+namespace Tsubasa
+{
+    // Batch versions of the hot math operations. Inputs are parallel arrays,
+    // element i of every span belongs together, and all spans of a call must
+    // have the same size. With SIMD enabled, four elements are transposed
+    // into one register per component and processed side by side; the
+    // remainder falls back to the scalar operations.
+
+    // result[i] = Matrix4x4::TRS(positions[i], rotations[i], scales[i]). The
+    // remainder is padded instead, so an element's result does not depend on
+    // where it falls in the batch.
+    void TRSBatch(Span<const Vector3> positions, Span<const Quaternion> rotations, Span<const Vector3> scales, Span<Matrix4x4> result);
+    void TRSBatch(Span<const Vector3> positions, Span<const Quaternion> rotations, Span<const Vector3> scales, Span<Affine3x4> result);
+    // result[i] = a[i] * b[i], result may alias a or b
+    void MultiplyBatch(Span<const Matrix4x4> a, Span<const Matrix4x4> b, Span<Matrix4x4> result);
+    void MultiplyBatch(Span<const Affine3x4> a, Span<const Affine3x4> b, Span<Affine3x4> result);
+    // result[i] = matrix * points[i], result may alias points
+    void TransformPoints(const Matrix4x4 &matrix, Span<const Vector3> points, Span<Vector3> result);
+    // result[i] = Quaternion::Slerp(a[i], b[i], t)
+    void QuaternionSlerpBatch(Span<const Quaternion> a, Span<const Quaternion> b, const float &t, Span<Quaternion> result);
+}
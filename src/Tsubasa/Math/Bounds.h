@@ -0,0 +1,161 @@
+#pragma once
+
+#include <Tsubasa/Math/Affine3x4.h>
+#include <Tsubasa/Math/Ray.h>
+#include <Tsubasa/Math/Vector3.h>
+#include <math.h>
+#include <type_traits>
+
+namespace Tsubasa
+{
+    // Axis-aligned box given by its center and half extents
+    class Bounds
+    {
+    public:
+        Vector3 Center, Extents;
+
+        Bounds() = default;
+        constexpr Bounds(const Vector3 &center, const Vector3 &extents) : Center(center), Extents(extents) {}
+
+        constexpr Vector3 GetMin() const;
+        constexpr Vector3 GetMax() const;
+        // Radius of the sphere around the center enclosing the box
+        float GetRadius() const;
+        constexpr float GetSurfaceArea() const;
+        // Smallest box enclosing this box after the transform
+        constexpr Bounds Transformed(const Affine3x4 &transform) const;
+        // Grown by margin on every side
+        constexpr Bounds Expanded(const float &margin) const;
+        // Smallest box enclosing both boxes
+        Bounds Merged(const Bounds &other) const;
+        constexpr bool Contains(const Bounds &other) const;
+        constexpr bool Intersects(const Bounds &other) const;
+        bool Intersects(const Vector3 &center, const float &radius) const;
+        // Distance along the ray to the entry point, 0 when the origin lies
+        // inside, or false when the ray misses within maxDistance
+        bool Raycast(const Ray &ray, const float &maxDistance, float &distance) const;
+
+        static constexpr Bounds FromMinMax(const Vector3 &min, const Vector3 &max);
+
+        static const Bounds Empty;
+    };
+
+    inline constexpr Bounds Bounds::Empty = Bounds(Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 0.0f));
+
+    constexpr Vector3 Bounds::GetMin() const
+    {
+        return Center - Extents;
+    }
+
+    constexpr Vector3 Bounds::GetMax() const
+    {
+        return Center + Extents;
+    }
+
+    inline float Bounds::GetRadius() const
+    {
+        return Extents.Magnitude();
+    }
+
+    constexpr float Bounds::GetSurfaceArea() const
+    {
+        return 8.0f * (Extents.x * Extents.y + Extents.y * Extents.z + Extents.z * Extents.x);
+    }
+
+    constexpr Bounds Bounds::Transformed(const Affine3x4 &transform) const
+    {
+        // Each world extent is the box extents projected on a row of the
+        // linear part, taken by absolute value
+        const float *m = transform.m;
+        const float a[9] = {m[0] < 0.0f ? -m[0] : m[0], m[1] < 0.0f ? -m[1] : m[1], m[2] < 0.0f ? -m[2] : m[2],
+                            m[4] < 0.0f ? -m[4] : m[4], m[5] < 0.0f ? -m[5] : m[5], m[6] < 0.0f ? -m[6] : m[6],
+                            m[8] < 0.0f ? -m[8] : m[8], m[9] < 0.0f ? -m[9] : m[9], m[10] < 0.0f ? -m[10] : m[10]};
+        return Bounds(transform * Center,
+                      Vector3(a[0] * Extents.x + a[1] * Extents.y + a[2] * Extents.z,
+                              a[3] * Extents.x + a[4] * Extents.y + a[5] * Extents.z,
+                              a[6] * Extents.x + a[7] * Extents.y + a[8] * Extents.z));
+    }
+
+    constexpr Bounds Bounds::Expanded(const float &margin) const
+    {
+        return Bounds(Center, Extents + Vector3(margin, margin, margin));
+    }
+
+    inline Bounds Bounds::Merged(const Bounds &other) const
+    {
+        return FromMinMax(Vector3::Min(GetMin(), other.GetMin()), Vector3::Max(GetMax(), other.GetMax()));
+    }
+
+    constexpr bool Bounds::Contains(const Bounds &other) const
+    {
+        const Vector3 min = GetMin(), max = GetMax();
+        const Vector3 otherMin = other.GetMin(), otherMax = other.GetMax();
+        return min.x <= otherMin.x && min.y <= otherMin.y && min.z <= otherMin.z &&
+               otherMax.x <= max.x && otherMax.y <= max.y && otherMax.z <= max.z;
+    }
+
+    constexpr bool Bounds::Intersects(const Bounds &other) const
+    {
+        const Vector3 offset = Center - other.Center;
+        const Vector3 reach = Extents + other.Extents;
+        return (offset.x < 0.0f ? -offset.x : offset.x) <= reach.x &&
+               (offset.y < 0.0f ? -offset.y : offset.y) <= reach.y &&
+               (offset.z < 0.0f ? -offset.z : offset.z) <= reach.z;
+    }
+
+    inline bool Bounds::Intersects(const Vector3 &center, const float &radius) const
+    {
+        // Squared distance from the center to the closest point of the box
+        const float x = fmaxf(fabsf(center.x - Center.x) - Extents.x, 0.0f);
+        const float y = fmaxf(fabsf(center.y - Center.y) - Extents.y, 0.0f);
+        const float z = fmaxf(fabsf(center.z - Center.z) - Extents.z, 0.0f);
+        return x * x + y * y + z * z <= radius * radius;
+    }
+
+    inline bool Bounds::Raycast(const Ray &ray, const float &maxDistance, float &distance) const
+    {
+        // Slab test, a ray parallel to a slab has to start inside it
+        const Vector3 min = GetMin(), max = GetMax();
+        const float origins[3] = {ray.Origin.x, ray.Origin.y, ray.Origin.z};
+        const float directions[3] = {ray.Direction.x, ray.Direction.y, ray.Direction.z};
+        const float mins[3] = {min.x, min.y, min.z};
+        const float maxs[3] = {max.x, max.y, max.z};
+        float enter = 0.0f;
+        float exit = maxDistance;
+        for (int i = 0; i < 3; i++)
+        {
+            if (directions[i] == 0.0f)
+            {
+                if (origins[i] < mins[i] || origins[i] > maxs[i])
+                {
+                    return false;
+                }
+                continue;
+            }
+            const float inverse = 1.0f / directions[i];
+            float near = (mins[i] - origins[i]) * inverse;
+            float far = (maxs[i] - origins[i]) * inverse;
+            if (near > far)
+            {
+                const float swap = near;
+                near = far;
+                far = swap;
+            }
+            enter = near > enter ? near : enter;
+            exit = far < exit ? far : exit;
+            if (enter > exit)
+            {
+                return false;
+            }
+        }
+        distance = enter;
+        return true;
+    }
+
+    constexpr Bounds Bounds::FromMinMax(const Vector3 &min, const Vector3 &max)
+    {
+        return Bounds((min + max) * 0.5f, (max - min) * 0.5f);
+    }
+
+    static_assert(std::is_trivially_copyable_v<Bounds>);
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <Tsubasa/Math/Affine3x4.h>
+#include <Tsubasa/Math/Bounds.h>
+#include <Tsubasa/Math/Vector3.h>
+#include <math.h>
+#include <type_traits>
+
+namespace Tsubasa
+{
+    // View volume as six planes facing inwards, in the order near, far,
+    // left, right, bottom, top. Cameras look down their local Forward axis.
+    class Frustum
+    {
+    public:
+        struct Plane
+        {
+            Vector3 Normal;
+            float Distance;
+
+            // Positive on the inner side
+            constexpr float SignedDistance(const Vector3 &point) const
+            {
+                return Normal.Dot(point) + Distance;
+            }
+        };
+
+        Plane Planes[6];
+
+        // Distance in front of the near plane, for sorting by depth
+        constexpr float Depth(const Vector3 &point) const;
+        // Conservative tests, shapes straddling a corner may pass
+        constexpr bool Intersects(const Bounds &bounds) const;
+        constexpr bool Intersects(const Vector3 &center, const float &radius) const;
+
+        // The camera transform must be free of scale, fovY is in radians
+        static Frustum Perspective(const Affine3x4 &camera, const float &fovY, const float &aspect, const float &near, const float &far);
+        static Frustum Orthographic(const Affine3x4 &camera, const float &halfHeight, const float &aspect, const float &near, const float &far);
+
+    private:
+        static Frustum fromAxes(const Affine3x4 &camera, const float &near, const float &far, Vector3 &right, Vector3 &up, Vector3 &forward);
+    };
+
+    constexpr float Frustum::Depth(const Vector3 &point) const
+    {
+        return Planes[0].SignedDistance(point);
+    }
+
+    constexpr bool Frustum::Intersects(const Bounds &bounds) const
+    {
+        for (const Plane &plane : Planes)
+        {
+            const Vector3 &n = plane.Normal;
+            const float reach = (n.x < 0.0f ? -n.x : n.x) * bounds.Extents.x + (n.y < 0.0f ? -n.y : n.y) * bounds.Extents.y + (n.z < 0.0f ? -n.z : n.z) * bounds.Extents.z;
+            if (plane.SignedDistance(bounds.Center) < -reach)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr bool Frustum::Intersects(const Vector3 &center, const float &radius) const
+    {
+        for (const Plane &plane : Planes)
+        {
+            if (plane.SignedDistance(center) < -radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    inline Frustum Frustum::Perspective(const Affine3x4 &camera, const float &fovY, const float &aspect, const float &near, const float &far)
+    {
+        Vector3 right, up, forward;
+        Frustum frustum = fromAxes(camera, near, far, right, up, forward);
+        const Vector3 position = camera.GetTranslation();
+        const float tanY = tanf(fovY * 0.5f);
+        const float tanX = tanY * aspect;
+        // Inside the right plane x <= z * tanX along the camera axes
+        const Vector3 normals[4] = {(forward * tanX + right) / sqrtf(1.0f + tanX * tanX),
+                                    (forward * tanX - right) / sqrtf(1.0f + tanX * tanX),
+                                    (forward * tanY + up) / sqrtf(1.0f + tanY * tanY),
+                                    (forward * tanY - up) / sqrtf(1.0f + tanY * tanY)};
+        for (int i = 0; i < 4; i++)
+        {
+            frustum.Planes[2 + i] = {normals[i], -normals[i].Dot(position)};
+        }
+        return frustum;
+    }
+
+    inline Frustum Frustum::Orthographic(const Affine3x4 &camera, const float &halfHeight, const float &aspect, const float &near, const float &far)
+    {
+        Vector3 right, up, forward;
+        Frustum frustum = fromAxes(camera, near, far, right, up, forward);
+        const Vector3 position = camera.GetTranslation();
+        const float halfWidth = halfHeight * aspect;
+        frustum.Planes[2] = {right, halfWidth - right.Dot(position)};
+        frustum.Planes[3] = {-right, halfWidth + right.Dot(position)};
+        frustum.Planes[4] = {up, halfHeight - up.Dot(position)};
+        frustum.Planes[5] = {-up, halfHeight + up.Dot(position)};
+        return frustum;
+    }
+
+    inline Frustum Frustum::fromAxes(const Affine3x4 &camera, const float &near, const float &far, Vector3 &right, Vector3 &up, Vector3 &forward)
+    {
+        // Columns of the linear part are the camera axes in world space
+        const float *m = camera.m;
+        right = Vector3(m[0], m[4], m[8]);
+        up = Vector3(m[1], m[5], m[9]);
+        forward = -Vector3(m[2], m[6], m[10]);
+        const Vector3 position = camera.GetTranslation();
+        Frustum frustum;
+        frustum.Planes[0] = {forward, -forward.Dot(position) - near};
+        frustum.Planes[1] = {-forward, forward.Dot(position) + far};
+        return frustum;
+    }
+
+    static_assert(std::is_trivially_copyable_v<Frustum>);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Tsubasa/Math/Vector3.h>
+#include <type_traits>
+
+namespace Tsubasa
+{
+    // Half line from an origin, the direction should be normalized so that
+    // distances along the ray are in world units
+    class Ray
+    {
+    public:
+        Vector3 Origin, Direction;
+
+        Ray() = default;
+        constexpr Ray(const Vector3 &origin, const Vector3 &direction) : Origin(origin), Direction(direction) {}
+
+        constexpr Vector3 GetPoint(const float &distance) const;
+    };
+
+    constexpr Vector3 Ray::GetPoint(const float &distance) const
+    {
+        return Origin + Direction * distance;
+    }
+
+    static_assert(std::is_trivially_copyable_v<Ray>);
+}
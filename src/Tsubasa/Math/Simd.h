@@ -0,0 +1,203 @@
+#pragma once
+
+// Selects the instruction set of the math kernels. TSUBASA_SIMD_AVX or
+// TSUBASA_SIMD_SSE come from the build, anything else or a target without
+// SSE2 falls back to plain scalar code.
+#if defined(TSUBASA_SIMD_AVX) && defined(__AVX__)
+#define TSUBASA_AVX 1
+#define TSUBASA_SSE 1
+#elif (defined(TSUBASA_SIMD_AVX) || defined(TSUBASA_SIMD_SSE)) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define TSUBASA_SSE 1
+#endif
+
+#if defined(TSUBASA_SSE)
+#include <immintrin.h>
+#endif
+
+#if defined(TSUBASA_SSE)
+
+namespace Tsubasa
+{
+    namespace Simd
+    {
+#define TSUBASA_SWIZZLE(vector, x, y, z, w) _mm_shuffle_ps((vector), (vector), _MM_SHUFFLE(w, z, y, x))
+
+        inline __m128 MultiplyAdd(const __m128 &a, const __m128 &b, const __m128 &c)
+        {
+#if defined(__FMA__)
+            return _mm_fmadd_ps(a, b, c);
+#else
+            return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+        }
+
+        // Row r of the product is the sum of the rows of b weighted by row r of a
+        inline void Multiply(const float *a, const float *b, float *result)
+        {
+#if defined(TSUBASA_AVX)
+            const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b));
+            const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 4));
+            const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 8));
+            const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 12));
+            for (int row = 0; row < 16; row += 8)
+            {
+                const __m256 rows = _mm256_loadu_ps(a + row);
+                __m256 sum = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x00), b0);
+#if defined(__FMA__)
+                sum = _mm256_fmadd_ps(_mm256_shuffle_ps(rows, rows, 0x55), b1, sum);
+                sum = _mm256_fmadd_ps(_mm256_shuffle_ps(rows, rows, 0xAA), b2, sum);
+                sum = _mm256_fmadd_ps(_mm256_shuffle_ps(rows, rows, 0xFF), b3, sum);
+#else
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x55), b1));
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xAA), b2));
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xFF), b3));
+#endif
+                _mm256_storeu_ps(result + row, sum);
+            }
+#else
+            const __m128 b0 = _mm_load_ps(b);
+            const __m128 b1 = _mm_load_ps(b + 4);
+            const __m128 b2 = _mm_load_ps(b + 8);
+            const __m128 b3 = _mm_load_ps(b + 12);
+            for (int row = 0; row < 16; row += 4)
+            {
+                const __m128 values = _mm_load_ps(a + row);
+                __m128 sum = _mm_mul_ps(TSUBASA_SWIZZLE(values, 0, 0, 0, 0), b0);
+                sum = MultiplyAdd(TSUBASA_SWIZZLE(values, 1, 1, 1, 1), b1, sum);
+                sum = MultiplyAdd(TSUBASA_SWIZZLE(values, 2, 2, 2, 2), b2, sum);
+                sum = MultiplyAdd(TSUBASA_SWIZZLE(values, 3, 3, 3, 3), b3, sum);
+                _mm_store_ps(result + row, sum);
+            }
+#endif
+        }
+
+        // Rows of b applied to the rows of a, both 3x4 affine transforms, the
+        // implicit (0, 0, 0, 1) row of a only contributes b's translation
+        inline void MultiplyAffine(const float *a, const float *b, float *result)
+        {
+            const __m128 translation = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+            const __m128 a0 = _mm_load_ps(a);
+            const __m128 a1 = _mm_load_ps(a + 4);
+            const __m128 a2 = _mm_load_ps(a + 8);
+            for (int row = 0; row < 12; row += 4)
+            {
+                const __m128 values = _mm_load_ps(b + row);
+                __m128 sum = _mm_and_ps(values, translation);
+                sum = MultiplyAdd(TSUBASA_SWIZZLE(values, 0, 0, 0, 0), a0, sum);
+                sum = MultiplyAdd(TSUBASA_SWIZZLE(values, 1, 1, 1, 1), a1, sum);
+                sum = MultiplyAdd(TSUBASA_SWIZZLE(values, 2, 2, 2, 2), a2, sum);
+                _mm_store_ps(result + row, sum);
+            }
+        }
+
+        // 2x2 blocks stored as (m00, m01, m10, m11)
+        inline __m128 Multiply2x2(const __m128 &a, const __m128 &b)
+        {
+            return _mm_add_ps(_mm_mul_ps(a, TSUBASA_SWIZZLE(b, 0, 3, 0, 3)), _mm_mul_ps(TSUBASA_SWIZZLE(a, 1, 0, 3, 2), TSUBASA_SWIZZLE(b, 2, 1, 2, 1)));
+        }
+
+        // adjugate(a) * b
+        inline __m128 AdjugateMultiply2x2(const __m128 &a, const __m128 &b)
+        {
+            return _mm_sub_ps(_mm_mul_ps(TSUBASA_SWIZZLE(a, 3, 3, 0, 0), b), _mm_mul_ps(TSUBASA_SWIZZLE(a, 1, 1, 2, 2), TSUBASA_SWIZZLE(b, 2, 3, 0, 1)));
+        }
+
+        // a * adjugate(b)
+        inline __m128 MultiplyAdjugate2x2(const __m128 &a, const __m128 &b)
+        {
+            return _mm_sub_ps(_mm_mul_ps(a, TSUBASA_SWIZZLE(b, 3, 0, 3, 0)), _mm_mul_ps(TSUBASA_SWIZZLE(a, 1, 0, 3, 2), TSUBASA_SWIZZLE(b, 2, 1, 2, 1)));
+        }
+
+        // General inverse through the 2x2 block decomposition
+        inline void Inverse(const float *matrix, float *result)
+        {
+            const __m128 row0 = _mm_load_ps(matrix);
+            const __m128 row1 = _mm_load_ps(matrix + 4);
+            const __m128 row2 = _mm_load_ps(matrix + 8);
+            const __m128 row3 = _mm_load_ps(matrix + 12);
+
+            const __m128 a = _mm_movelh_ps(row0, row1);
+            const __m128 b = _mm_movehl_ps(row1, row0);
+            const __m128 c = _mm_movelh_ps(row2, row3);
+            const __m128 d = _mm_movehl_ps(row3, row2);
+
+            // Determinants of the blocks as (|A|, |B|, |C|, |D|)
+            const __m128 determinants = _mm_sub_ps(
+                _mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+                _mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0))));
+            const __m128 determinantA = TSUBASA_SWIZZLE(determinants, 0, 0, 0, 0);
+            const __m128 determinantB = TSUBASA_SWIZZLE(determinants, 1, 1, 1, 1);
+            const __m128 determinantC = TSUBASA_SWIZZLE(determinants, 2, 2, 2, 2);
+            const __m128 determinantD = TSUBASA_SWIZZLE(determinants, 3, 3, 3, 3);
+
+            const __m128 dc = AdjugateMultiply2x2(d, c);
+            const __m128 ab = AdjugateMultiply2x2(a, b);
+            __m128 x = _mm_sub_ps(_mm_mul_ps(determinantD, a), Multiply2x2(b, dc));
+            __m128 w = _mm_sub_ps(_mm_mul_ps(determinantA, d), Multiply2x2(c, ab));
+            __m128 y = _mm_sub_ps(_mm_mul_ps(determinantB, c), MultiplyAdjugate2x2(d, ab));
+            __m128 z = _mm_sub_ps(_mm_mul_ps(determinantC, b), MultiplyAdjugate2x2(a, dc));
+
+            __m128 determinant = _mm_add_ps(_mm_mul_ps(determinantA, determinantD), _mm_mul_ps(determinantB, determinantC));
+            __m128 trace = _mm_mul_ps(ab, TSUBASA_SWIZZLE(dc, 0, 2, 1, 3));
+            trace = _mm_add_ps(trace, TSUBASA_SWIZZLE(trace, 2, 3, 0, 1));
+            trace = _mm_add_ps(trace, TSUBASA_SWIZZLE(trace, 1, 0, 3, 2));
+            determinant = _mm_sub_ps(determinant, trace);
+
+            const __m128 inverseDeterminant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+            x = _mm_mul_ps(x, inverseDeterminant);
+            y = _mm_mul_ps(y, inverseDeterminant);
+            z = _mm_mul_ps(z, inverseDeterminant);
+            w = _mm_mul_ps(w, inverseDeterminant);
+
+            _mm_store_ps(result, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_store_ps(result + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+            _mm_store_ps(result + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_store_ps(result + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+        }
+
+        // Rotation rows of a unit quaternion (x, y, z, w), each scaled by one
+        // scale component, followed by the translation row
+        inline void TRS(const float &px, const float &py, const float &pz, const __m128 &quaternion, const float &sx, const float &sy, const float &sz, float *result)
+        {
+            const __m128 mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+            const __m128 doubled = _mm_add_ps(quaternion, quaternion);
+            const __m128 squares = _mm_mul_ps(quaternion, doubled);
+
+            __m128 v0 = _mm_and_ps(TSUBASA_SWIZZLE(squares, 1, 0, 0, 3), mask);
+            __m128 v1 = _mm_and_ps(TSUBASA_SWIZZLE(squares, 2, 2, 1, 3), mask);
+            const __m128 diagonal = _mm_sub_ps(_mm_sub_ps(_mm_setr_ps(1.0f, 1.0f, 1.0f, 0.0f), v0), v1);
+
+            v0 = _mm_mul_ps(TSUBASA_SWIZZLE(quaternion, 0, 0, 1, 3), TSUBASA_SWIZZLE(doubled, 2, 1, 2, 3));
+            v1 = _mm_mul_ps(TSUBASA_SWIZZLE(quaternion, 3, 3, 3, 3), TSUBASA_SWIZZLE(doubled, 1, 2, 0, 3));
+            const __m128 sum = _mm_add_ps(v0, v1);
+            const __m128 difference = _mm_sub_ps(v0, v1);
+
+            v0 = _mm_shuffle_ps(sum, difference, _MM_SHUFFLE(1, 0, 2, 1));
+            v0 = TSUBASA_SWIZZLE(v0, 0, 2, 3, 1);
+            v1 = _mm_shuffle_ps(sum, difference, _MM_SHUFFLE(2, 2, 0, 0));
+            v1 = TSUBASA_SWIZZLE(v1, 0, 2, 0, 2);
+
+            __m128 row = _mm_shuffle_ps(diagonal, v0, _MM_SHUFFLE(1, 0, 3, 0));
+            _mm_store_ps(result, _mm_mul_ps(TSUBASA_SWIZZLE(row, 0, 2, 3, 1), _mm_set1_ps(sx)));
+            row = _mm_shuffle_ps(diagonal, v0, _MM_SHUFFLE(3, 2, 3, 1));
+            _mm_store_ps(result + 4, _mm_mul_ps(TSUBASA_SWIZZLE(row, 2, 0, 3, 1), _mm_set1_ps(sy)));
+            row = _mm_shuffle_ps(v1, diagonal, _MM_SHUFFLE(3, 2, 1, 0));
+            _mm_store_ps(result + 8, _mm_mul_ps(row, _mm_set1_ps(sz)));
+            _mm_store_ps(result + 12, _mm_setr_ps(px, py, pz, 1.0f));
+        }
+
+        // Hamilton product of quaternions stored as (x, y, z, w)
+        inline __m128 QuaternionMultiply(const __m128 &a, const __m128 &b)
+        {
+            const __m128 flipW = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, static_cast<int>(0x80000000u)));
+            __m128 result = _mm_mul_ps(TSUBASA_SWIZZLE(a, 3, 3, 3, 3), b);
+            result = _mm_add_ps(result, _mm_xor_ps(_mm_mul_ps(TSUBASA_SWIZZLE(a, 0, 1, 2, 0), TSUBASA_SWIZZLE(b, 3, 3, 3, 0)), flipW));
+            result = _mm_add_ps(result, _mm_xor_ps(_mm_mul_ps(TSUBASA_SWIZZLE(a, 1, 2, 0, 1), TSUBASA_SWIZZLE(b, 2, 0, 1, 1)), flipW));
+            return _mm_sub_ps(result, _mm_mul_ps(TSUBASA_SWIZZLE(a, 2, 0, 1, 2), TSUBASA_SWIZZLE(b, 1, 2, 0, 2)));
+        }
+
+#undef TSUBASA_SWIZZLE
+    }
+}
+
+#endif
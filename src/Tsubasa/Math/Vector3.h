@@ -1,58 +1,334 @@
-#pragma once
-
-namespace Tsubasa
-{
-    class Vector3
-    {
-    public:
-        float x, y, z;
-
-        Vector3();
-        Vector3(const float &x, const float &y, const float &z);
-        ~Vector3();
-
-        float Angle(const Vector3 &other) const;
-        Vector3 Cross(const Vector3 &other) const;
-        float Distance(const Vector3 &other) const;
-        float Dot(const Vector3 &other) const;
-        Vector3 Lerp(const Vector3 &other, float t) const;
-        float Magnitude() const;
-        Vector3 Max(const Vector3 &other) const;
-        Vector3 Min(const Vector3 &other) const;
-        void Normalize();
-        Vector3 Normalized() const;
-        Vector3 Project(const Vector3 &other) const;
-        Vector3 Reflect(const Vector3 &normal) const;
-        Vector3 Scale(const Vector3 &other) const;
-
-        static Vector3 Cross(const Vector3 &a, const Vector3 &b);
-        static float Distance(const Vector3 &a, const Vector3 &b);
-        static float Dot(const Vector3 &a, const Vector3 &b);
-        static Vector3 Lerp(const Vector3 &a, const Vector3 &b, float t);
-        static float Magnitude(const Vector3 &v);
-        static Vector3 Max(const Vector3 &a, const Vector3 &b);
-        static Vector3 Min(const Vector3 &a, const Vector3 &b);
-        static Vector3 Normalize(const Vector3 &v);
-        static Vector3 Project(const Vector3 &a, const Vector3 &b);
-        static Vector3 Reflect(const Vector3 &a, const Vector3 &normal);
-        static Vector3 Scale(const Vector3 &a, const Vector3 &b);
-
-        static const Vector3 Zero, One, Back, Down, Forward, Left, Right, Up;
-
-        Vector3 operator+(const Vector3 &other) const;
-        Vector3 operator+=(const Vector3 &other);
-        Vector3 operator-(const Vector3 &other) const;
-        Vector3 operator-() const;
-        Vector3 operator-=(const Vector3 &other);
-        Vector3 operator*(const float &number) const;
-        Vector3 operator*=(const float &number);
-        Vector3 operator*(const Vector3 &other) const;
-        Vector3 operator*=(const Vector3 &other);
-        Vector3 operator/(const float &number) const;
-        Vector3 operator/=(const float &number);
-        Vector3 operator/(const Vector3 &other) const;
-        Vector3 operator/=(const Vector3 &other);
-        bool operator==(const Vector3 &other) const;
-        bool operator!=(const Vector3 &other) const;
-    };
-}
\ No newline at end of file
+#pragma once
+
+#include <math.h>
+#include <type_traits>
+
+namespace Tsubasa
+{
+    class Vector3
+    {
+    public:
+        float x, y, z;
+
+        Vector3() = default;
+        constexpr Vector3(const float &x, const float &y, const float &z) : x(x), y(y), z(z) {}
+
+        float Angle(const Vector3 &other) const;
+        constexpr Vector3 Cross(const Vector3 &other) const;
+        float Distance(const Vector3 &other) const;
+        constexpr float Dot(const Vector3 &other) const;
+        constexpr Vector3 Lerp(const Vector3 &other, float t) const;
+        float Magnitude() const;
+        Vector3 Max(const Vector3 &other) const;
+        Vector3 Min(const Vector3 &other) const;
+        void Normalize();
+        Vector3 Normalized() const;
+        constexpr Vector3 Project(const Vector3 &other) const;
+        constexpr Vector3 Reflect(const Vector3 &normal) const;
+        constexpr Vector3 Scale(const Vector3 &other) const;
+
+        static constexpr Vector3 Cross(const Vector3 &a, const Vector3 &b);
+        static float Distance(const Vector3 &a, const Vector3 &b);
+        static constexpr float Dot(const Vector3 &a, const Vector3 &b);
+        static constexpr Vector3 Lerp(const Vector3 &a, const Vector3 &b, float t);
+        static float Magnitude(const Vector3 &v);
+        static Vector3 Max(const Vector3 &a, const Vector3 &b);
+        static Vector3 Min(const Vector3 &a, const Vector3 &b);
+        static Vector3 Normalize(const Vector3 &v);
+        static constexpr Vector3 Project(const Vector3 &a, const Vector3 &b);
+        static constexpr Vector3 Reflect(const Vector3 &a, const Vector3 &normal);
+        static constexpr Vector3 Scale(const Vector3 &a, const Vector3 &b);
+
+        static const Vector3 Zero, One, Back, Down, Forward, Left, Right, Up;
+
+        constexpr Vector3 operator+(const Vector3 &other) const;
+        constexpr Vector3 operator+=(const Vector3 &other);
+        constexpr Vector3 operator-(const Vector3 &other) const;
+        constexpr Vector3 operator-() const;
+        constexpr Vector3 operator-=(const Vector3 &other);
+        constexpr Vector3 operator*(const float &number) const;
+        constexpr Vector3 operator*=(const float &number);
+        constexpr Vector3 operator*(const Vector3 &other) const;
+        constexpr Vector3 operator*=(const Vector3 &other);
+        constexpr Vector3 operator/(const float &number) const;
+        constexpr Vector3 operator/=(const float &number);
+        constexpr Vector3 operator/(const Vector3 &other) const;
+        constexpr Vector3 operator/=(const Vector3 &other);
+        constexpr bool operator==(const Vector3 &other) const;
+        constexpr bool operator!=(const Vector3 &other) const;
+    };
+
+    inline constexpr Vector3 Vector3::Zero = Vector3(0.0f, 0.0f, 0.0f);
+    inline constexpr Vector3 Vector3::One = Vector3(1.0f, 1.0f, 1.0f);
+    inline constexpr Vector3 Vector3::Back = Vector3(0.0f, 0.0f, 1.0f);
+    inline constexpr Vector3 Vector3::Down = Vector3(0.0f, -1.0f, 0.0f);
+    inline constexpr Vector3 Vector3::Forward = Vector3(0.0f, 0.0f, -1.0f);
+    inline constexpr Vector3 Vector3::Left = Vector3(-1.0f, 0.0f, 0.0f);
+    inline constexpr Vector3 Vector3::Right = Vector3(1.0f, 0.0f, 0.0f);
+    inline constexpr Vector3 Vector3::Up = Vector3(0.0f, 1.0f, 0.0f);
+
+    inline float Vector3::Angle(const Vector3 &other) const
+    {
+        Vector3 cross = {y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x};
+        float len = sqrtf(cross.x * cross.x + cross.y * cross.y + cross.z * cross.z);
+        float dot = (x * other.x + y * other.y + z * other.z);
+
+        return atan2f(len, dot);
+    }
+
+    constexpr Vector3 Vector3::Cross(const Vector3 &other) const
+    {
+        return Vector3(y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x);
+    }
+
+    inline float Vector3::Distance(const Vector3 &other) const
+    {
+        float dx = other.x - x;
+        float dy = other.y - y;
+        float dz = other.z - z;
+
+        return sqrtf(dx * dx + dy * dy + dz * dz);
+    }
+
+    constexpr float Vector3::Dot(const Vector3 &other) const
+    {
+        return x * other.x + y * other.y + z * other.z;
+    }
+
+    constexpr Vector3 Vector3::Lerp(const Vector3 &other, float t) const
+    {
+        return Vector3(x + (other.x - x) * t, y + (other.y - y) * t, z + (other.z - z) * t);
+    }
+
+    inline float Vector3::Magnitude() const
+    {
+        return sqrtf(x * x + y * y + z * z);
+    }
+
+    inline Vector3 Vector3::Max(const Vector3 &other) const
+    {
+        return Vector3(fmaxf(x, other.x), fmaxf(y, other.y), fmaxf(z, other.z));
+    }
+
+    inline Vector3 Vector3::Min(const Vector3 &other) const
+    {
+        return Vector3(fminf(x, other.x), fminf(y, other.y), fminf(z, other.z));
+    }
+
+    inline void Vector3::Normalize()
+    {
+        float length = sqrtf(x * x + y * y + z * z);
+        if (length != 0.0f)
+        {
+            float ilength = 1.0f / length;
+
+            x *= ilength;
+            y *= ilength;
+            z *= ilength;
+        }
+    }
+
+    inline Vector3 Vector3::Normalized() const
+    {
+        float length = sqrtf(x * x + y * y + z * z);
+        if (length != 0.0f)
+        {
+            float ilength = 1.0f / length;
+
+            return Vector3(x * ilength, y * ilength, z * ilength);
+        }
+
+        return Vector3::Zero;
+    }
+
+    constexpr Vector3 Vector3::Project(const Vector3 &other) const
+    {
+        float v1dv2 = (x * other.x + y * other.y + z * other.z);
+        float v2dv2 = (other.x * other.x + other.y * other.y + other.z * other.z);
+
+        float mag = v1dv2 / v2dv2;
+
+        return Vector3(other.x * mag, other.y * mag, other.z * mag);
+    }
+
+    constexpr Vector3 Vector3::Reflect(const Vector3 &normal) const
+    {
+        float dotProduct = (x * normal.x + y * normal.y + z * normal.z);
+
+        return Vector3(x - (2.0f * normal.x) * dotProduct, y - (2.0f * normal.y) * dotProduct, z - (2.0f * normal.z) * dotProduct);
+    }
+
+    constexpr Vector3 Vector3::Scale(const Vector3 &other) const
+    {
+        return Vector3(x * other.x, y * other.y, z * other.z);
+    }
+
+    constexpr Vector3 Vector3::Cross(const Vector3 &a, const Vector3 &b)
+    {
+        return Vector3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+
+    inline float Vector3::Distance(const Vector3 &a, const Vector3 &b)
+    {
+        float dx = b.x - a.x;
+        float dy = b.y - a.y;
+        float dz = b.z - a.z;
+
+        return sqrtf(dx * dx + dy * dy + dz * dz);
+    }
+
+    constexpr float Vector3::Dot(const Vector3 &a, const Vector3 &b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    constexpr Vector3 Vector3::Lerp(const Vector3 &a, const Vector3 &b, float t)
+    {
+        return Vector3(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t);
+    }
+
+    inline float Vector3::Magnitude(const Vector3 &v)
+    {
+        return sqrtf(v.x * v.x + v.y * v.y + v.z * v.z);
+    }
+
+    inline Vector3 Vector3::Max(const Vector3 &a, const Vector3 &b)
+    {
+        return Vector3(fmaxf(a.x, b.x), fmaxf(a.y, b.y), fmaxf(a.z, b.z));
+    }
+
+    inline Vector3 Vector3::Min(const Vector3 &a, const Vector3 &b)
+    {
+        return Vector3(fminf(a.x, b.x), fminf(a.y, b.y), fminf(a.z, b.z));
+    }
+
+    inline Vector3 Vector3::Normalize(const Vector3 &v)
+    {
+        float length = sqrtf(v.x * v.x + v.y * v.y + v.z * v.z);
+        if (length != 0.0f)
+        {
+            float ilength = 1.0f / length;
+
+            return Vector3(v.x * ilength, v.y * ilength, v.z * ilength);
+        }
+
+        return Vector3::Zero;
+    }
+
+    constexpr Vector3 Vector3::Project(const Vector3 &a, const Vector3 &b)
+    {
+        float v1dv2 = a.x * b.x + a.y * b.y + a.z * b.z;
+        float v2dv2 = b.x * b.x + b.y * b.y + b.z * b.z;
+
+        float mag = v1dv2 / v2dv2;
+
+        return Vector3(b.x * mag, b.y * mag, b.z * mag);
+    }
+
+    constexpr Vector3 Vector3::Reflect(const Vector3 &a, const Vector3 &normal)
+    {
+        float dotProduct = a.x * normal.x + a.y * normal.y + a.z * normal.z;
+
+        return Vector3(a.x - (2.0f * normal.x) * dotProduct, a.y - (2.0f * normal.y) * dotProduct, a.z - (2.0f * normal.z) * dotProduct);
+    }
+
+    constexpr Vector3 Vector3::Scale(const Vector3 &a, const Vector3 &b)
+    {
+        return Vector3(a.x * b.x, a.y * b.y, a.z * b.z);
+    }
+
+    constexpr Vector3 Vector3::operator+(const Vector3 &other) const
+    {
+        return Vector3(x + other.x, y + other.y, z + other.z);
+    }
+
+    constexpr Vector3 Vector3::operator+=(const Vector3 &other)
+    {
+        x += other.x;
+        y += other.y;
+        z += other.z;
+        return *this;
+    }
+
+    constexpr Vector3 Vector3::operator-(const Vector3 &other) const
+    {
+        return Vector3(x - other.x, y - other.y, z - other.z);
+    }
+
+    constexpr Vector3 Vector3::operator-=(const Vector3 &other)
+    {
+        x -= other.x;
+        y -= other.y;
+        z -= other.z;
+        return *this;
+    }
+
+    constexpr Vector3 Vector3::operator-() const
+    {
+        return Vector3(-x, -y, -z);
+    }
+
+    constexpr Vector3 Vector3::operator*(const float &number) const
+    {
+        return Vector3(x * number, y * number, z * number);
+    }
+
+    constexpr Vector3 Vector3::operator*=(const float &number)
+    {
+        x *= number;
+        y *= number;
+        z *= number;
+        return *this;
+    }
+
+    constexpr Vector3 Vector3::operator*(const Vector3 &other) const
+    {
+        return Vector3(x * other.x, y * other.y, z * other.z);
+    }
+
+    constexpr Vector3 Vector3::operator*=(const Vector3 &other)
+    {
+        x *= other.x;
+        y *= other.y;
+        z *= other.z;
+        return *this;
+    }
+
+    constexpr Vector3 Vector3::operator/(const float &number) const
+    {
+        return Vector3(x / number, y / number, z / number);
+    }
+
+    constexpr Vector3 Vector3::operator/=(const float &number)
+    {
+        x /= number;
+        y /= number;
+        z /= number;
+        return *this;
+    }
+
+    constexpr Vector3 Vector3::operator/(const Vector3 &other) const
+    {
+        return Vector3(x / other.x, y / other.y, z / other.z);
+    }
+
+    constexpr Vector3 Vector3::operator/=(const Vector3 &other)
+    {
+        x /= other.x;
+        y /= other.y;
+        z /= other.z;
+        return *this;
+    }
+
+    constexpr bool Vector3::operator==(const Vector3 &other) const
+    {
+        return x == other.x && y == other.y && z == other.z;
+    }
+
+    constexpr bool Vector3::operator!=(const Vector3 &other) const
+    {
+        return x != other.x || y != other.y || z != other.z;
+    }
+
+    static_assert(std::is_trivially_copyable_v<Vector3>);
+}
@@ -0,0 +1,95 @@
+#include <Tsubasa/Memory/Arena.h>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+namespace Tsubasa
+{
+    const size_t Arena::DefaultBlockSize = 1 << 20;
+
+    Arena::Arena(const size_t &blockSize)
+    {
+        this->blockSize = std::max<size_t>(blockSize, 64);
+        offset = 0;
+        live = 0;
+    }
+
+    Arena::~Arena()
+    {
+        const bool released = Release();
+        assert(released && "Arena destroyed while objects allocated from it are alive");
+        (void)released;
+    }
+
+    void *Arena::Allocate(const size_t &size, const size_t &alignment)
+    {
+        if (!blocks.empty())
+        {
+            Block &block = blocks.back();
+            const uintptr_t base = reinterpret_cast<uintptr_t>(block.Data);
+            const size_t start = ((base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+            if (start + size <= block.Size)
+            {
+                offset = start + size;
+                live++;
+                return block.Data + start;
+            }
+        }
+        // Oversized requests get a block of their own
+        const size_t newSize = std::max(blockSize, size + alignment);
+        char *data = static_cast<char *>(::operator new(newSize, std::align_val_t(alignof(std::max_align_t))));
+        blocks.push_back({data, newSize});
+        offset = 0;
+        return Allocate(size, alignment);
+    }
+
+    void Arena::Deallocate(void *pointer)
+    {
+        assert(owns(pointer) && "Pointer was not allocated from this arena");
+        (void)pointer;
+        live--;
+    }
+
+    bool Arena::Release()
+    {
+        if (live > 0)
+        {
+            return false;
+        }
+        for (const auto &block : blocks)
+        {
+            ::operator delete(block.Data, std::align_val_t(alignof(std::max_align_t)));
+        }
+        blocks.clear();
+        offset = 0;
+        return true;
+    }
+
+    bool Arena::owns(const void *pointer) const
+    {
+        const char *address = static_cast<const char *>(pointer);
+        return std::any_of(blocks.begin(), blocks.end(), [address](const Block &block)
+                           { return address >= block.Data && address < block.Data + block.Size; });
+    }
+
+    size_t Arena::GetLiveCount() const
+    {
+        return live;
+    }
+
+    size_t Arena::GetBlockSize() const
+    {
+        return blockSize;
+    }
+
+    size_t Arena::GetReservedSize() const
+    {
+        size_t size = 0;
+        for (const auto &block : blocks)
+        {
+            size += block.Size;
+        }
+        return size;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Tsubasa
+{
+    // Bump allocator for the nodes and components of one scene. Freed
+    // objects are only counted, their memory comes back when the whole arena
+    // is released, which needs every object allocated from it gone first.
+    // ArenaAllocator shares ownership of the arena, so objects that outlive
+    // their scene keep its blocks alive until they are gone.
+    class Arena
+    {
+    public:
+        Arena(const size_t &blockSize = DefaultBlockSize);
+        // Asserts that no object from it is still alive
+        ~Arena();
+
+        void *Allocate(const size_t &size, const size_t &alignment);
+        void Deallocate(void *pointer);
+        // Frees every block at once. Returns false, keeping the blocks, while
+        // allocations from the arena are still alive.
+        bool Release();
+
+        // Allocations not yet deallocated
+        size_t GetLiveCount() const;
+        // Bytes held in blocks
+        size_t GetReservedSize() const;
+        size_t GetBlockSize() const;
+
+        static const size_t DefaultBlockSize;
+
+    private:
+        struct Block
+        {
+            char *Data;
+            size_t Size;
+        };
+
+        size_t blockSize;
+        std::vector<Block> blocks;
+        size_t offset;
+        size_t live;
+
+        bool owns(const void *pointer) const;
+    };
+
+    // Standard allocator drawing from an Arena, for std::allocate_shared
+    template <typename T>
+    class ArenaAllocator
+    {
+        template <typename U>
+        friend class ArenaAllocator;
+
+    public:
+        using value_type = T;
+
+        ArenaAllocator(const std::shared_ptr<Arena> &arena) noexcept : arena(arena) {}
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena(other.arena) {}
+
+        T *allocate(std::size_t count)
+        {
+            return static_cast<T *>(arena->Allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *pointer, std::size_t)
+        {
+            arena->Deallocate(pointer);
+        }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U> &other) const noexcept
+        {
+            return arena == other.arena;
+        }
+
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U> &other) const noexcept
+        {
+            return arena != other.arena;
+        }
+
+    private:
+        std::shared_ptr<Arena> arena;
+    };
+}
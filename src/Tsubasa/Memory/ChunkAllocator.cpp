@@ -0,0 +1,52 @@
+#include <Tsubasa/Memory/ChunkAllocator.h>
+#include <algorithm>
+
+namespace Tsubasa
+{
+    ChunkPool::ChunkPool(const size_t &slotSize, const size_t &alignment)
+    {
+        this->alignment = std::max(alignment, alignof(FreeSlot));
+        this->slotSize = (std::max(slotSize, sizeof(FreeSlot)) + this->alignment - 1) / this->alignment * this->alignment;
+        slotsPerChunk = std::max<size_t>(ChunkSize / this->slotSize, 1);
+        freeSlots = nullptr;
+    }
+
+    ChunkPool::~ChunkPool()
+    {
+        for (const auto &chunk : chunks)
+        {
+            ::operator delete(chunk, std::align_val_t(alignment));
+        }
+    }
+
+    void *ChunkPool::Allocate()
+    {
+        if (freeSlots == nullptr)
+        {
+            grow();
+        }
+        FreeSlot *slot = freeSlots;
+        freeSlots = slot->next;
+        return slot;
+    }
+
+    void ChunkPool::Deallocate(void *slot)
+    {
+        FreeSlot *freeSlot = static_cast<FreeSlot *>(slot);
+        freeSlot->next = freeSlots;
+        freeSlots = freeSlot;
+    }
+
+    const size_t ChunkPool::ChunkSize = 16384;
+
+    void ChunkPool::grow()
+    {
+        char *chunk = static_cast<char *>(::operator new(slotSize * slotsPerChunk, std::align_val_t(alignment)));
+        chunks.push_back(chunk);
+        // Thread the new slots in address order so consecutive allocations stay adjacent
+        for (size_t i = slotsPerChunk; i-- > 0;)
+        {
+            Deallocate(chunk + i * slotSize);
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace Tsubasa
+{
+    // Fixed-size slots carved out of large chunks, recycled through a free list
+    class ChunkPool
+    {
+    public:
+        ChunkPool(const size_t &slotSize, const size_t &alignment);
+        ~ChunkPool();
+
+        void *Allocate();
+        void Deallocate(void *slot);
+
+        static const size_t ChunkSize;
+
+    private:
+        struct FreeSlot
+        {
+            FreeSlot *next;
+        };
+
+        size_t slotSize;
+        size_t alignment;
+        size_t slotsPerChunk;
+        std::vector<void *> chunks;
+        FreeSlot *freeSlots;
+
+        void grow();
+    };
+
+    // Standard allocator whose single-object allocations come from a pool
+    // dedicated to the allocated type. Used with std::allocate_shared, every
+    // object of one type (together with its control block) ends up packed
+    // next to its siblings instead of scattered across the heap.
+    template <typename T>
+    class ChunkAllocator
+    {
+    public:
+        using value_type = T;
+
+        ChunkAllocator() noexcept {}
+        template <typename U>
+        ChunkAllocator(const ChunkAllocator<U> &) noexcept {}
+
+        T *allocate(std::size_t count)
+        {
+            if (count == 1)
+            {
+                return static_cast<T *>(pool().Allocate());
+            }
+            return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+        }
+
+        void deallocate(T *pointer, std::size_t count)
+        {
+            if (count == 1)
+            {
+                pool().Deallocate(pointer);
+            }
+            else
+            {
+                ::operator delete(pointer, std::align_val_t(alignof(T)));
+            }
+        }
+
+        template <typename U>
+        bool operator==(const ChunkAllocator<U> &) const noexcept
+        {
+            return true;
+        }
+
+        template <typename U>
+        bool operator!=(const ChunkAllocator<U> &) const noexcept
+        {
+            return false;
+        }
+
+    private:
+        static ChunkPool &pool()
+        {
+            // Never destroyed, objects may be released during static destruction
+            static ChunkPool *instance = new ChunkPool(sizeof(T), alignof(T));
+            return *instance;
+        }
+    };
+}
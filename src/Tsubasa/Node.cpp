@@ -1,423 +1,487 @@
-#include <Tsubasa/Node.h>
-#include <Tsubasa/Application.h>
-#include <algorithm>
-#include <queue>
-
-namespace Tsubasa
-{
-    Node::Node() : Client(application), Parent(parent), Children(children), Components(components), Transform(transform), LocalPosition(localPosition), LocalRotation(localRotation), LocalScale(localScale)
-    {
-        transform = Matrix4x4::Identity;
-        localPosition = Vector3::Zero;
-        localRotation = Quaternion::Identity;
-        localScale = Vector3::One;
-        dirty = false;
-    }
-
-    Node::~Node()
-    {
-        for (const auto &component : components)
-        {
-            component->OnDestroy();
-        }
-    }
-
-    bool Node::SetParent(const std::shared_ptr<Node> &newParent)
-    {
-        if (parent != newParent && newParent != nullptr && newParent != shared_from_this())
-        {
-            if (parent != nullptr)
-            {
-                parent->children.erase(std::remove(parent->children.begin(), parent->children.end(), shared_from_this()), parent->children.end());
-            }
-            application = newParent->application;
-            parent = newParent;
-            parent->children.push_back(shared_from_this());
-            makeDirty();
-            return true;
-        }
-        else
-        {
-            return false;
-        }
-    }
-
-    const std::shared_ptr<Node> Node::AddChild(const std::shared_ptr<Node> &child)
-    {
-        if (child == nullptr)
-        {
-            std::shared_ptr<Node> newNode = std::make_shared<Node>();
-            if (newNode->SetParent(shared_from_this()))
-            {
-                return newNode;
-            }
-            else
-            {
-                return nullptr;
-            }
-        }
-        else
-        {
-            child->SetParent(shared_from_this());
-            return child;
-        }
-    }
-
-    bool Node::HasChild(const std::shared_ptr<Node> &child) const
-    {
-        return std::find(children.begin(), children.end(), child) != children.end();
-    }
-
-    const std::shared_ptr<Node> Node::RemoveChild(const std::shared_ptr<Node> &child)
-    {
-        auto it = std::find(children.begin(), children.end(), child);
-        if (it != children.end())
-        {
-            children.erase(it);
-            child->parent = nullptr;
-            child->application = nullptr;
-            return child;
-        }
-        return nullptr;
-    }
-
-    bool Node::HasComponent(const std::shared_ptr<Component> &component) const
-    {
-        return std::find(components.begin(), components.end(), component) != components.end();
-    }
-
-    const std::shared_ptr<Component> Node::RemoveComponent(const std::shared_ptr<Component> &component)
-    {
-        auto it = std::find(components.begin(), components.end(), component);
-        if (it != components.end())
-        {
-            component->OnDestroy();
-            components.erase(it);
-            component->entity = nullptr;
-            return component;
-        }
-        return nullptr;
-    }
-
-    void Node::Translate(const float &x, const float &y, const float &z, const Space &space)
-    {
-        if (space == Space::World)
-        {
-            SetWorldPosition(GetWorldPosition() + Vector3(x, y, z));
-        }
-        else
-        {
-            SetLocalPosition(LocalPosition + Vector3(x, y, z));
-        }
-    }
-    
-    void Node::Translate(const Vector3 &translation, const Space &space)
-    {
-        if (space == Space::World)
-        {
-            SetWorldPosition(GetWorldPosition() + translation);
-        }
-        else
-        {
-            SetLocalPosition(LocalPosition + translation);
-        }
-    }
-
-    void Node::Rotate(const Quaternion &rotation, const Space &space)
-    {
-        if (space == Space::World)
-        {
-            SetWorldRotation(GetWorldRotation() * rotation);
-        }
-        else
-        {
-            SetLocalRotation(LocalRotation * rotation);
-        }
-    }
-
-    void Node::Rotate(const float &x, const float &y, const float &z, const Space &space)
-    {
-        if (space == Space::World)
-        {
-            SetWorldRotation(GetWorldRotation() * Quaternion::FromEuler(x, y, z));
-        }
-        else
-        {
-            SetLocalRotation(LocalRotation * Quaternion::FromEuler(x, y, z));
-        }
-    }
-
-    void Node::Rotate(const Vector3 &euler, const Space &space)
-    {
-        if (space == Space::World)
-        {
-            SetWorldRotation(GetWorldRotation() * Quaternion::FromEuler(euler));
-        }
-        else
-        {
-            SetLocalRotation(LocalRotation * Quaternion::FromEuler(euler));
-        }
-    }
-
-    void Node::Scale(const float &x, const float &y, const float &z, const Space &space)
-    {
-        if (space == Space::World)
-        {
-            SetWorldScale(GetWorldScale() + Vector3(x, y, z));
-        }
-        else
-        {
-            SetLocalScale(LocalScale + Vector3(x, y, z));
-        }
-    }
-
-    void Node::Scale(const Vector3 &scale, const Space &space)
-    {
-        if (space == Space::World)
-        {
-            SetWorldScale(GetWorldScale() + scale);
-        }
-        else
-        {
-            SetLocalScale(LocalScale + scale);
-        }
-    }
-
-    void Node::SetLocalPosition(const float &x, const float &y, const float &z)
-    {
-        localPosition = Vector3(x, y, z);
-        makeDirty();
-    }
-
-    void Node::SetLocalPosition(const Vector3 &position)
-    {
-        localPosition = position;
-        makeDirty();
-    }
-
-    void Node::SetLocalRotation(const Quaternion &rotation)
-    {
-        localRotation = rotation;
-        makeDirty();
-    }
-
-    void Node::SetLocalRotation(const float &x, const float &y, const float &z)
-    {
-        localRotation = Quaternion::FromEuler(x, y, z);
-        makeDirty();
-    }
-
-    void Node::SetLocalRotation(const Vector3 &euler)
-    {
-        localRotation = Quaternion::FromEuler(euler);
-        makeDirty();
-    }
-
-    void Node::SetLocalScale(const float &x, const float &y, const float &z)
-    {
-        localScale = Vector3(x, y, z);
-        makeDirty();
-    }
-
-    void Node::SetLocalScale(const Vector3 &scale)
-    {
-        localScale = scale;
-        makeDirty();
-    }
-
-    Vector3 Node::GetWorldPosition()
-    {
-        if (parent)
-        {
-            if (dirty)
-            {
-                updateTransform();
-            }
-            return transform * Vector3::Zero;
-        }
-        else
-        {
-            return LocalPosition;
-        }
-    }
-
-    Vector3 Node::TransformPoint(const Vector3 &offset)
-    {
-        if (parent)
-        {
-            if (dirty)
-            {
-                updateTransform();
-            }
-            return transform * offset;
-        }
-        else
-        {
-            return LocalPosition + offset;
-        }
-    }
-
-    void Node::SetWorldPosition(const float &x, const float &y, const float &z)
-    {
-        if (parent)
-        {
-            if (parent->dirty)
-            {
-                parent->updateTransform();
-            }
-            SetLocalPosition(parent->transform.Inversed() * Vector3(x, y, z));
-        }
-        else
-        {
-            SetLocalPosition(Vector3(x, y, z));
-        }
-    }
-
-    void Node::SetWorldPosition(const Vector3 &position)
-    {
-        if (parent)
-        {
-            if (parent->dirty)
-            {
-                parent->updateTransform();
-            }
-            SetLocalPosition(parent->transform.Inversed() * position);
-        }
-        else
-        {
-            SetLocalPosition(position);
-        }
-    }
-
-    Quaternion Node::GetWorldRotation() const
-    {
-        if (parent)
-        {
-            return parent->GetWorldRotation() * localRotation;
-        }
-        else
-        {
-            return localRotation;
-        }
-    }
-
-    void Node::SetWorldRotation(const Quaternion &rotation)
-    {
-        if (parent)
-        {
-            SetLocalRotation(parent->GetWorldRotation().Inverse() * rotation);
-        }
-        else
-        {
-            SetLocalRotation(rotation);
-        }
-    }
-
-    void Node::SetWorldRotation(const float &x, const float &y, const float &z)
-    {
-        if (parent)
-        {
-            SetLocalRotation(parent->GetWorldRotation().Inverse() * Quaternion::FromEuler(x, y, z));
-        }
-        else
-        {
-            SetLocalRotation(Quaternion::FromEuler(x, y, z));
-        }
-    }
-
-    void Node::SetWorldRotation(const Vector3 &euler)
-    {
-        if (parent)
-        {
-            SetLocalRotation(parent->GetWorldRotation().Inverse() * Quaternion::FromEuler(euler));
-        }
-        else
-        {
-            SetLocalRotation(Quaternion::FromEuler(euler));
-        }
-    }
-
-    Vector3 Node::GetWorldScale() const
-    {
-        if (parent)
-        {
-            return localScale * parent->GetWorldScale();
-        }
-        else
-        {
-            return localScale;
-        }
-    }
-
-    void Node::SetWorldScale(const float &x, const float &y, const float &z)
-    {
-        if (parent)
-        {
-            const Vector3 &worldScale = parent->GetWorldScale();
-            SetLocalScale(Vector3(x / worldScale.x, y / worldScale.y, z / worldScale.z));
-        }
-        else
-        {
-            SetLocalScale(Vector3(x, y, z));
-        }
-    }
-
-    void Node::SetWorldScale(const Vector3 &scale)
-    {
-        if (parent)
-        {
-            SetLocalScale(scale / parent->GetWorldScale());
-        }
-        else
-        {
-            SetLocalScale(scale);
-        }
-    }
-
-    void Node::Traverse(const std::function<void(const std::shared_ptr<Node> &node)> &callback)
-    {
-        std::queue<std::shared_ptr<Node>> queue;
-        queue.push(shared_from_this());
-        while (!queue.empty())
-        {
-            auto current = queue.front();
-            queue.pop();
-            callback(current);
-            for (const auto &child : current->children)
-            {
-                queue.push(child);
-            }
-        }
-    }
-
-    void Node::makeDirty()
-    {
-        dirty = true;
-        for (const auto &child : children)
-        {
-            child->makeDirty();
-        }
-    }
-
-    void Node::updateTransform()
-    {
-        if (dirty)
-        {
-            if (parent)
-            {
-                if (parent->dirty)
-                {
-                    parent->updateTransform();
-                }
-                transform = Matrix4x4::TRS(LocalPosition, LocalRotation, LocalScale) * parent->Transform;
-                // transform = Matrix4x4::Scale(LocalScale) * Matrix4x4::Rotate(LocalRotation) * Matrix4x4::Translate(LocalPosition) * parent->Transform;
-            }
-            else
-            {
-                transform = Matrix4x4::TRS(LocalPosition, LocalRotation, LocalScale);
-                // transform = Matrix4x4::Scale(LocalScale) * Matrix4x4::Rotate(LocalRotation) * Matrix4x4::Translate(LocalPosition);
-            }
-            dirty = false;
-        }
-    }
+#include <Tsubasa/Node.h>
+#include <Tsubasa/Application.h>
+#include <algorithm>
+
+namespace Tsubasa
+{
+    Node::Node() : Client(application), Parent(parent), Children(children), Components(components)
+    {
+        application = nullptr;
+        handle = HandleTable<Node>::Shared().Allocate(this);
+        transformIndex = TransformStore::Shared().Allocate(this);
+    }
+
+    Node::~Node()
+    {
+        for (const auto &component : components)
+        {
+            component->destroy();
+            if (component->storage != nullptr)
+            {
+                component->storage->Remove(component.get());
+            }
+        }
+        for (const auto &child : children)
+        {
+            TransformStore::Shared().SetParent(child->transformIndex, TransformStore::Invalid);
+            TransformStore::Shared().MakeDirty(child->transformIndex);
+            // Children only held by this node are destroyed right after it
+            if (child.use_count() > 1)
+            {
+                child->setApplication(nullptr);
+            }
+        }
+        TransformStore::Shared().Release(transformIndex);
+        HandleTable<Node>::Shared().Release(handle);
+    }
+
+    bool Node::SetParent(const std::shared_ptr<Node> &newParent)
+    {
+        Node *oldParent = parent.Get();
+        if (oldParent != newParent.get() && newParent != nullptr && newParent.get() != this)
+        {
+            // Keeps this node alive while it moves between the two lists
+            std::shared_ptr<Node> self = shared_from_this();
+            if (oldParent != nullptr)
+            {
+                oldParent->children.erase(std::remove(oldParent->children.begin(), oldParent->children.end(), self), oldParent->children.end());
+            }
+            setApplication(newParent->application);
+            parent = newParent->handle;
+            newParent->children.push_back(std::move(self));
+            TransformStore::Shared().SetParent(transformIndex, newParent->transformIndex);
+            makeDirty();
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    const std::shared_ptr<Node> Node::AddChild(const std::shared_ptr<Node> &child)
+    {
+        if (child == nullptr)
+        {
+            const std::shared_ptr<Arena> arena = getArena();
+            std::shared_ptr<Node> newNode = arena != nullptr ? std::allocate_shared<Node>(ArenaAllocator<Node>(arena)) : std::allocate_shared<Node>(ChunkAllocator<Node>());
+            if (newNode->SetParent(shared_from_this()))
+            {
+                return newNode;
+            }
+            else
+            {
+                return nullptr;
+            }
+        }
+        else
+        {
+            child->SetParent(shared_from_this());
+            return child;
+        }
+    }
+
+    bool Node::HasChild(const std::shared_ptr<Node> &child) const
+    {
+        return std::find(children.begin(), children.end(), child) != children.end();
+    }
+
+    const std::shared_ptr<Node> Node::RemoveChild(const std::shared_ptr<Node> &child)
+    {
+        auto it = std::find(children.begin(), children.end(), child);
+        if (it != children.end())
+        {
+            children.erase(it);
+            child->parent = nullptr;
+            child->setApplication(nullptr);
+            TransformStore::Shared().SetParent(child->transformIndex, TransformStore::Invalid);
+            child->makeDirty();
+            return child;
+        }
+        return nullptr;
+    }
+
+    bool Node::HasComponent(const std::shared_ptr<Component> &component) const
+    {
+        return std::find(components.begin(), components.end(), component) != components.end();
+    }
+
+    const std::shared_ptr<Component> Node::RemoveComponent(const std::shared_ptr<Component> &component)
+    {
+        auto it = std::find(components.begin(), components.end(), component);
+        if (it != components.end())
+        {
+            component->destroy();
+            components.erase(it);
+            if (component->storage != nullptr)
+            {
+                component->storage->Remove(component.get());
+            }
+            reindexComponents();
+            component->entity = nullptr;
+            return component;
+        }
+        return nullptr;
+    }
+
+    void Node::Translate(const float &x, const float &y, const float &z, const Space &space)
+    {
+        if (space == Space::World)
+        {
+            SetWorldPosition(GetWorldPosition() + Vector3(x, y, z));
+        }
+        else
+        {
+            SetLocalPosition(GetLocalPosition() + Vector3(x, y, z));
+        }
+    }
+    
+    void Node::Translate(const Vector3 &translation, const Space &space)
+    {
+        if (space == Space::World)
+        {
+            SetWorldPosition(GetWorldPosition() + translation);
+        }
+        else
+        {
+            SetLocalPosition(GetLocalPosition() + translation);
+        }
+    }
+
+    void Node::Rotate(const Quaternion &rotation, const Space &space)
+    {
+        if (space == Space::World)
+        {
+            SetWorldRotation(GetWorldRotation() * rotation);
+        }
+        else
+        {
+            SetLocalRotation(GetLocalRotation() * rotation);
+        }
+    }
+
+    void Node::Rotate(const float &x, const float &y, const float &z, const Space &space)
+    {
+        if (space == Space::World)
+        {
+            SetWorldRotation(GetWorldRotation() * Quaternion::FromEuler(x, y, z));
+        }
+        else
+        {
+            SetLocalRotation(GetLocalRotation() * Quaternion::FromEuler(x, y, z));
+        }
+    }
+
+    void Node::Rotate(const Vector3 &euler, const Space &space)
+    {
+        if (space == Space::World)
+        {
+            SetWorldRotation(GetWorldRotation() * Quaternion::FromEuler(euler));
+        }
+        else
+        {
+            SetLocalRotation(GetLocalRotation() * Quaternion::FromEuler(euler));
+        }
+    }
+
+    void Node::Scale(const float &x, const float &y, const float &z, const Space &space)
+    {
+        if (space == Space::World)
+        {
+            SetWorldScale(GetWorldScale() + Vector3(x, y, z));
+        }
+        else
+        {
+            SetLocalScale(GetLocalScale() + Vector3(x, y, z));
+        }
+    }
+
+    void Node::Scale(const Vector3 &scale, const Space &space)
+    {
+        if (space == Space::World)
+        {
+            SetWorldScale(GetWorldScale() + scale);
+        }
+        else
+        {
+            SetLocalScale(GetLocalScale() + scale);
+        }
+    }
+
+    void Node::SetLocalPosition(const float &x, const float &y, const float &z)
+    {
+        TransformStore::Shared().localPositions[transformIndex] = Vector3(x, y, z);
+        makeDirty();
+    }
+
+    void Node::SetLocalPosition(const Vector3 &position)
+    {
+        TransformStore::Shared().localPositions[transformIndex] = position;
+        makeDirty();
+    }
+
+    void Node::SetLocalRotation(const Quaternion &rotation)
+    {
+        TransformStore::Shared().localRotations[transformIndex] = rotation;
+        makeDirty();
+    }
+
+    void Node::SetLocalRotation(const float &x, const float &y, const float &z)
+    {
+        TransformStore::Shared().localRotations[transformIndex] = Quaternion::FromEuler(x, y, z);
+        makeDirty();
+    }
+
+    void Node::SetLocalRotation(const Vector3 &euler)
+    {
+        TransformStore::Shared().localRotations[transformIndex] = Quaternion::FromEuler(euler);
+        makeDirty();
+    }
+
+    void Node::SetLocalScale(const float &x, const float &y, const float &z)
+    {
+        TransformStore::Shared().localScales[transformIndex] = Vector3(x, y, z);
+        makeDirty();
+    }
+
+    void Node::SetLocalScale(const Vector3 &scale)
+    {
+        TransformStore::Shared().localScales[transformIndex] = scale;
+        makeDirty();
+    }
+
+    Vector3 Node::GetLocalPosition() const
+    {
+        return TransformStore::Shared().localPositions[transformIndex];
+    }
+
+    Quaternion Node::GetLocalRotation() const
+    {
+        return TransformStore::Shared().localRotations[transformIndex];
+    }
+
+    Vector3 Node::GetLocalScale() const
+    {
+        return TransformStore::Shared().localScales[transformIndex];
+    }
+
+    Vector3 Node::GetWorldPosition()
+    {
+        if (parent != nullptr)
+        {
+            TransformStore &store = TransformStore::Shared();
+            store.Resolve(transformIndex);
+            return store.worlds[transformIndex].GetTranslation();
+        }
+        else
+        {
+            return GetLocalPosition();
+        }
+    }
+
+    Vector3 Node::TransformPoint(const Vector3 &offset)
+    {
+        if (parent != nullptr)
+        {
+            TransformStore &store = TransformStore::Shared();
+            store.Resolve(transformIndex);
+            return store.worlds[transformIndex] * offset;
+        }
+        else
+        {
+            return GetLocalPosition() + offset;
+        }
+    }
+
+    void Node::SetWorldPosition(const float &x, const float &y, const float &z)
+    {
+        if (Node *parentNode = parent.Get())
+        {
+            TransformStore &store = TransformStore::Shared();
+            store.Resolve(parentNode->transformIndex);
+            SetLocalPosition(store.worlds[parentNode->transformIndex].Inversed() * Vector3(x, y, z));
+        }
+        else
+        {
+            SetLocalPosition(Vector3(x, y, z));
+        }
+    }
+
+    void Node::SetWorldPosition(const Vector3 &position)
+    {
+        if (Node *parentNode = parent.Get())
+        {
+            TransformStore &store = TransformStore::Shared();
+            store.Resolve(parentNode->transformIndex);
+            SetLocalPosition(store.worlds[parentNode->transformIndex].Inversed() * position);
+        }
+        else
+        {
+            SetLocalPosition(position);
+        }
+    }
+
+    Quaternion Node::GetWorldRotation() const
+    {
+        TransformStore &store = TransformStore::Shared();
+        store.Resolve(transformIndex);
+        return store.worldRotations[transformIndex];
+    }
+
+    void Node::SetWorldRotation(const Quaternion &rotation)
+    {
+        if (Node *parentNode = parent.Get())
+        {
+            SetLocalRotation(parentNode->GetWorldRotation().Inverse() * rotation);
+        }
+        else
+        {
+            SetLocalRotation(rotation);
+        }
+    }
+
+    void Node::SetWorldRotation(const float &x, const float &y, const float &z)
+    {
+        if (Node *parentNode = parent.Get())
+        {
+            SetLocalRotation(parentNode->GetWorldRotation().Inverse() * Quaternion::FromEuler(x, y, z));
+        }
+        else
+        {
+            SetLocalRotation(Quaternion::FromEuler(x, y, z));
+        }
+    }
+
+    void Node::SetWorldRotation(const Vector3 &euler)
+    {
+        if (Node *parentNode = parent.Get())
+        {
+            SetLocalRotation(parentNode->GetWorldRotation().Inverse() * Quaternion::FromEuler(euler));
+        }
+        else
+        {
+            SetLocalRotation(Quaternion::FromEuler(euler));
+        }
+    }
+
+    Vector3 Node::GetWorldScale() const
+    {
+        TransformStore &store = TransformStore::Shared();
+        store.Resolve(transformIndex);
+        return store.worldScales[transformIndex];
+    }
+
+    void Node::SetWorldScale(const float &x, const float &y, const float &z)
+    {
+        if (Node *parentNode = parent.Get())
+        {
+            const Vector3 worldScale = parentNode->GetWorldScale();
+            SetLocalScale(Vector3(x / worldScale.x, y / worldScale.y, z / worldScale.z));
+        }
+        else
+        {
+            SetLocalScale(Vector3(x, y, z));
+        }
+    }
+
+    void Node::SetWorldScale(const Vector3 &scale)
+    {
+        if (Node *parentNode = parent.Get())
+        {
+            SetLocalScale(scale / parentNode->GetWorldScale());
+        }
+        else
+        {
+            SetLocalScale(scale);
+        }
+    }
+
+    Affine3x4 Node::GetTransform()
+    {
+        TransformStore &store = TransformStore::Shared();
+        store.Resolve(transformIndex);
+        return store.worlds[transformIndex];
+    }
+
+    Affine3x4 Node::GetInterpolatedTransform(const float &alpha)
+    {
+        TransformStore &store = TransformStore::Shared();
+        store.Resolve(transformIndex);
+        return store.Interpolate(transformIndex, alpha);
+    }
+
+    void Node::Traverse(const std::function<void(Node &node)> &callback)
+    {
+        // The tree owns every node visited, so plain pointers suffice
+        std::vector<Node *> queue;
+        queue.push_back(this);
+        for (size_t i = 0; i < queue.size(); i++)
+        {
+            Node *current = queue[i];
+            callback(*current);
+            for (const auto &child : current->children)
+            {
+                queue.push_back(child.get());
+            }
+        }
+    }
+
+    NodeHandle Node::GetHandle() const
+    {
+        return handle;
+    }
+
+    void Node::makeDirty()
+    {
+        TransformStore::Shared().MakeDirty(transformIndex);
+    }
+
+    void Node::setApplication(Application *newApplication)
+    {
+        if (application != newApplication)
+        {
+            for (const auto &component : components)
+            {
+                component->MarkChanged();
+            }
+        }
+        application = newApplication;
+        for (const auto &child : children)
+        {
+            child->setApplication(newApplication);
+        }
+    }
+
+    std::shared_ptr<Arena> Node::getArena() const
+    {
+        return application != nullptr ? application->GetArena() : nullptr;
+    }
+
+    void Node::attachComponent(const std::shared_ptr<Component> &component, const uint32_t &typeId, ComponentStorage &storage)
+    {
+        component->entity = handle;
+        component->typeId = typeId;
+        component->destroyed = false;
+        if (!componentMask.test(typeId))
+        {
+            if (typeId >= componentIndices.size())
+            {
+                componentIndices.resize(typeId + 1);
+            }
+            componentMask.set(typeId);
+            componentIndices[typeId] = static_cast<uint16_t>(components.size());
+        }
+        components.push_back(component);
+        storage.Add(component.get(), this);
+    }
+
+    void Node::reindexComponents()
+    {
+        componentMask.reset();
+        for (size_t i = components.size(); i-- > 0;)
+        {
+            componentMask.set(components[i]->typeId);
+            componentIndices[components[i]->typeId] = static_cast<uint16_t>(i);
+        }
+    }
 }
\ No newline at end of file
@@ -1,157 +1,210 @@
-#pragma once
-
-#include <functional>
-#include <initializer_list>
-#include <memory>
-#include <vector>
-#include <Tsubasa/Component.h>
-#include <Tsubasa/Math/Matrix4x4.h>
-#include <Tsubasa/Math/Vector3.h>
-#include <Tsubasa/Math/Quaternion.h>
-
-namespace Tsubasa
-{
-    enum class Space
-    {
-        World,
-        Local
-    };
-
-    class Application;
-
-    class Node : public std::enable_shared_from_this<Node>
-    {
-        friend class Application;
-    public:
-        Node();
-        ~Node();
-
-        // Hierarchichy
-        bool SetParent(const std::shared_ptr<Node> &newParent);
-        const std::shared_ptr<Node> AddChild(const std::shared_ptr<Node> &child = nullptr);
-        bool HasChild(const std::shared_ptr<Node> &child) const;
-        const std::shared_ptr<Node> RemoveChild(const std::shared_ptr<Node> &child);
-        // Components
-        template <typename T>
-        const std::shared_ptr<T> AddComponent(const std::shared_ptr<T> &component);
-        template <typename T, typename... Args>
-        const std::shared_ptr<T> AddComponent(Args... args);
-        bool HasComponent(const std::shared_ptr<Component> &component) const;
-        const std::shared_ptr<Component> RemoveComponent(const std::shared_ptr<Component> &component);
-        template <typename T>
-        std::shared_ptr<T> GetComponent()
-        {
-            for (auto &component : components)
-            {
-                if (std::dynamic_pointer_cast<T>(component))
-                {
-                    return std::dynamic_pointer_cast<T>(component);
-                }
-            }
-            return nullptr;
-        }
-        // Local space
-        void Translate(const float &x, const float &y, const float &z, const Space &space = Space::Local);
-        void Translate(const Vector3 &translation, const Space &space = Space::Local);
-        void Rotate(const Quaternion &rotation, const Space &space = Space::Local);
-        void Rotate(const float &x, const float &y, const float &z, const Space &space = Space::Local);
-        void Rotate(const Vector3 &euler, const Space &space = Space::Local);
-        void Scale(const float &x, const float &y, const float &z, const Space &space = Space::Local);
-        void Scale(const Vector3 &scale, const Space &space = Space::Local);
-        void SetLocalPosition(const float &x, const float &y, const float &z);
-        void SetLocalPosition(const Vector3 &position);
-        void SetLocalRotation(const Quaternion &rotation);
-        void SetLocalRotation(const float &x, const float &y, const float &z);
-        void SetLocalRotation(const Vector3 &euler);
-        void SetLocalScale(const float &x, const float &y, const float &z);
-        void SetLocalScale(const Vector3 &scale);
-        // World space
-        Vector3 GetWorldPosition();
-        Vector3 TransformPoint(const Vector3 &offset);
-        void SetWorldPosition(const float &x, const float &y, const float &z);
-        void SetWorldPosition(const Vector3 &position);
-        Quaternion GetWorldRotation() const;
-        void SetWorldRotation(const Quaternion &rotation);
-        void SetWorldRotation(const float &x, const float &y, const float &z);
-        void SetWorldRotation(const Vector3 &euler);
-        Vector3 GetWorldScale() const;
-        void SetWorldScale(const float &x, const float &y, const float &z);
-        void SetWorldScale(const Vector3 &scale);
-        // Traverse
-        void Traverse(const std::function<void(const std::shared_ptr<Node> &node)> &callback);
-        template <typename T>
-        void Traverse(const std::function<void(const std::shared_ptr<T> &node)> &callback)
-        {
-            Traverse([callback](const std::shared_ptr<Node> &node)
-                     {
-                auto component = node->GetComponent<T>();
-                if (component != nullptr)
-                {
-                    callback(component);
-                }
-            });
-        }
-
-        const std::shared_ptr<Node> &Parent;
-        const std::vector<std::shared_ptr<Node>> &Children;
-        std::vector<std::shared_ptr<Component>> &Components;
-
-        const std::shared_ptr<Application> &Client;
-        const Vector3 &LocalPosition;
-        const Quaternion &LocalRotation;
-        const Vector3 &LocalScale;
-        const Matrix4x4 &Transform;
-
-    private:
-        std::shared_ptr<Application> application;
-        std::shared_ptr<Node> parent;
-        std::vector<std::shared_ptr<Node>> children;
-        std::vector<std::shared_ptr<Component>> components;
-        bool dirty;
-        Matrix4x4 transform;
-        Vector3 localPosition;
-        Quaternion localRotation;
-        Vector3 localScale;
-
-        void makeDirty();
-        void updateTransform();
-    };
-
-    template <typename T>
-    const std::shared_ptr<T> Node::AddComponent(const std::shared_ptr<T> &component)
-    {
-        if (component == nullptr)
-        {
-            std::shared_ptr<T> newComponent = std::make_shared<T>();
-            newComponent->entity = shared_from_this();
-            components.push_back(newComponent);
-            newComponent->OnInit();
-            return newComponent;
-        }
-        else if (component->Entity != shared_from_this())
-        {
-            if (component->Entity != nullptr)
-            {
-                component->Entity->RemoveComponent(component);
-            }
-            component->entity = shared_from_this();
-            components.push_back(component);
-            component->OnInit();
-            return component;
-        }
-        else
-        {
-            return nullptr;
-        }
-    }
-
-    template <typename T, typename... Args>
-    const std::shared_ptr<T> Node::AddComponent(Args... args)
-    {
-        std::shared_ptr<T> newComponent = std::make_shared<T>(args...);
-        newComponent->entity = shared_from_this();
-        components.push_back(newComponent);
-        newComponent->OnInit();
-        return newComponent;
-    }
+#pragma once
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <typeinfo>
+#include <vector>
+#include <Tsubasa/Component.h>
+#include <Tsubasa/ComponentRegistry.h>
+#include <Tsubasa/Handle.h>
+#include <Tsubasa/TransformStore.h>
+#include <Tsubasa/Memory/Arena.h>
+#include <Tsubasa/Memory/ChunkAllocator.h>
+#include <Tsubasa/Math/Affine3x4.h>
+#include <Tsubasa/Math/Matrix4x4.h>
+#include <Tsubasa/Math/Vector3.h>
+#include <Tsubasa/Math/Quaternion.h>
+
+namespace Tsubasa
+{
+    enum class Space
+    {
+        World,
+        Local
+    };
+
+    class Application;
+
+    // Nodes own their children and components. Every reference back up the
+    // tree, to the parent, the owning node of a component or the
+    // application, is non-owning, so releasing the root releases the scene.
+    class Node : public std::enable_shared_from_this<Node>
+    {
+        friend class Application;
+        friend class SpatialIndex;
+        friend class TransformStore;
+        template <typename T>
+        friend T *FindComponent(Node *entity);
+    public:
+        Node();
+        ~Node();
+
+        // Hierarchichy
+        bool SetParent(const std::shared_ptr<Node> &newParent);
+        const std::shared_ptr<Node> AddChild(const std::shared_ptr<Node> &child = nullptr);
+        bool HasChild(const std::shared_ptr<Node> &child) const;
+        const std::shared_ptr<Node> RemoveChild(const std::shared_ptr<Node> &child);
+        // Components
+        template <typename T>
+        const std::shared_ptr<T> AddComponent(const std::shared_ptr<T> &component);
+        template <typename T, typename... Args>
+        const std::shared_ptr<T> AddComponent(Args... args);
+        bool HasComponent(const std::shared_ptr<Component> &component) const;
+        template <typename T>
+        bool HasComponent() const
+        {
+            const uint32_t typeId = ComponentTypeId::Of<T>();
+            return typeId < MaxComponentTypes && componentMask.test(typeId);
+        }
+        const std::shared_ptr<Component> RemoveComponent(const std::shared_ptr<Component> &component);
+        // Looks up the component added with exactly type T, base classes do not match
+        template <typename T>
+        std::shared_ptr<T> GetComponent()
+        {
+            const uint32_t typeId = ComponentTypeId::Of<T>();
+            if (typeId < MaxComponentTypes && componentMask.test(typeId))
+            {
+                return std::static_pointer_cast<T>(components[componentIndices[typeId]]);
+            }
+            return nullptr;
+        }
+        // Local space
+        void Translate(const float &x, const float &y, const float &z, const Space &space = Space::Local);
+        void Translate(const Vector3 &translation, const Space &space = Space::Local);
+        void Rotate(const Quaternion &rotation, const Space &space = Space::Local);
+        void Rotate(const float &x, const float &y, const float &z, const Space &space = Space::Local);
+        void Rotate(const Vector3 &euler, const Space &space = Space::Local);
+        void Scale(const float &x, const float &y, const float &z, const Space &space = Space::Local);
+        void Scale(const Vector3 &scale, const Space &space = Space::Local);
+        void SetLocalPosition(const float &x, const float &y, const float &z);
+        void SetLocalPosition(const Vector3 &position);
+        void SetLocalRotation(const Quaternion &rotation);
+        void SetLocalRotation(const float &x, const float &y, const float &z);
+        void SetLocalRotation(const Vector3 &euler);
+        void SetLocalScale(const float &x, const float &y, const float &z);
+        void SetLocalScale(const Vector3 &scale);
+        Vector3 GetLocalPosition() const;
+        Quaternion GetLocalRotation() const;
+        Vector3 GetLocalScale() const;
+        // World space
+        Vector3 GetWorldPosition();
+        Vector3 TransformPoint(const Vector3 &offset);
+        void SetWorldPosition(const float &x, const float &y, const float &z);
+        void SetWorldPosition(const Vector3 &position);
+        Quaternion GetWorldRotation() const;
+        void SetWorldRotation(const Quaternion &rotation);
+        void SetWorldRotation(const float &x, const float &y, const float &z);
+        void SetWorldRotation(const Vector3 &euler);
+        // Product of the local scales up to the root, skew from rotated
+        // non-uniform scales is not represented
+        Vector3 GetWorldScale() const;
+        void SetWorldScale(const float &x, const float &y, const float &z);
+        void SetWorldScale(const Vector3 &scale);
+        Affine3x4 GetTransform();
+        // World matrix to render with, see Application::Interpolation
+        Affine3x4 GetInterpolatedTransform(const float &alpha);
+        // Traverse breadth-first, the callback must not add or remove nodes
+        void Traverse(const std::function<void(Node &node)> &callback);
+        template <typename T>
+        void Traverse(const std::function<void(T &component)> &callback)
+        {
+            Traverse([&callback](Node &node)
+                     {
+                T *component = FindComponent<T>(&node);
+                if (component != nullptr)
+                {
+                    callback(*component);
+                }
+            });
+        }
+        NodeHandle GetHandle() const;
+
+        const NodeHandle &Parent;
+        const std::vector<std::shared_ptr<Node>> &Children;
+        std::vector<std::shared_ptr<Component>> &Components;
+
+        Application *const &Client;
+
+    private:
+        Application *application;
+        NodeHandle parent;
+        NodeHandle handle;
+        std::vector<std::shared_ptr<Node>> children;
+        std::vector<std::shared_ptr<Component>> components;
+        uint32_t transformIndex;
+        ComponentMask componentMask;
+        std::vector<uint16_t> componentIndices;
+
+        void attachComponent(const std::shared_ptr<Component> &component, const uint32_t &typeId, ComponentStorage &storage);
+        void reindexComponents();
+        void makeDirty();
+        void setApplication(Application *newApplication);
+        // Scene arena of the application, if it uses one
+        std::shared_ptr<Arena> getArena() const;
+        template <typename T, typename... Args>
+        std::shared_ptr<T> createComponent(Args... args) const;
+    };
+
+    template <typename T>
+    const std::shared_ptr<T> Node::AddComponent(const std::shared_ptr<T> &component)
+    {
+        if (component == nullptr)
+        {
+            std::shared_ptr<T> newComponent = createComponent<T>();
+            attachComponent(newComponent, ComponentTypeId::Of<T>(), ComponentRegistry::Shared().Storage<T>());
+            newComponent->OnInit();
+            return newComponent;
+        }
+        else if (component->Entity.Get() != this)
+        {
+            if (component->Entity != nullptr)
+            {
+                component->Entity->RemoveComponent(component);
+            }
+            ComponentStorage &storage = ComponentRegistry::Shared().Storage<T>();
+            if (typeid(*component) != typeid(T))
+            {
+                storage.UseVirtualUpdate();
+            }
+            attachComponent(component, ComponentTypeId::Of<T>(), storage);
+            component->OnInit();
+            return component;
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+
+    template <typename T, typename... Args>
+    const std::shared_ptr<T> Node::AddComponent(Args... args)
+    {
+        std::shared_ptr<T> newComponent = createComponent<T>(args...);
+        attachComponent(newComponent, ComponentTypeId::Of<T>(), ComponentRegistry::Shared().Storage<T>());
+        newComponent->OnInit();
+        return newComponent;
+    }
+
+    template <typename T, typename... Args>
+    std::shared_ptr<T> Node::createComponent(Args... args) const
+    {
+        const std::shared_ptr<Arena> arena = getArena();
+        if (arena != nullptr)
+        {
+            return std::allocate_shared<T>(ArenaAllocator<T>(arena), args...);
+        }
+        return std::allocate_shared<T>(ChunkAllocator<T>(), args...);
+    }
+
+    template <typename T>
+    T *FindComponent(Node *entity)
+    {
+        const uint32_t typeId = ComponentTypeId::Of<T>();
+        if (typeId < MaxComponentTypes && entity->componentMask.test(typeId))
+        {
+            return static_cast<T *>(entity->components[entity->componentIndices[typeId]].get());
+        }
+        return nullptr;
+    }
 }
\ No newline at end of file
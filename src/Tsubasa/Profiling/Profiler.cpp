@@ -0,0 +1,190 @@
+#include <Tsubasa/Profiling/Profiler.h>
+
+#ifdef TSUBASA_PROFILE
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#if defined(__GNUG__)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+namespace Tsubasa
+{
+    namespace
+    {
+        const auto origin = std::chrono::steady_clock::now();
+        std::atomic<uint32_t> threadCount(0);
+        thread_local uint32_t threadIndex = threadCount++;
+        thread_local uint32_t depth = 0;
+
+        void writeEscaped(std::ostream &stream, const std::string &text)
+        {
+            for (const char &character : text)
+            {
+                if (character == '"' || character == '\\')
+                {
+                    stream << '\\';
+                }
+                stream << character;
+            }
+        }
+    }
+
+    const size_t Profiler::FrameCapacity = 240;
+
+    Profiler::Scope::Scope(const char *name) : name(name)
+    {
+        depth++;
+        start = Now();
+    }
+
+    Profiler::Scope::~Scope()
+    {
+        uint64_t end = Now();
+        depth--;
+        Profiler::Shared().Record(name, start, end, depth);
+    }
+
+    Profiler::Profiler()
+    {
+        frames.resize(FrameCapacity);
+        current = 0;
+        recorded = 0;
+    }
+
+    Profiler::~Profiler() {}
+
+    void Profiler::BeginFrame()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        frames[current].Events.clear();
+        frames[current].Start = Now();
+        frames[current].Duration = 0;
+        frames[current].Thread = threadIndex;
+    }
+
+    void Profiler::EndFrame()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        frames[current].Duration = Now() - frames[current].Start;
+        current = (current + 1) % FrameCapacity;
+        recorded = std::min(recorded + 1, FrameCapacity);
+    }
+
+    void Profiler::Record(const char *name, const uint64_t &start, const uint64_t &end, const uint32_t &depth)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        frames[current].Events.push_back({name, start, end - start, threadIndex, depth});
+    }
+
+    std::vector<Profiler::Frame> Profiler::GetFrames() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<Frame> result;
+        result.reserve(recorded);
+        for (size_t i = 0; i < recorded; i++)
+        {
+            result.push_back(frames[(current + FrameCapacity - recorded + i) % FrameCapacity]);
+        }
+        return result;
+    }
+
+    std::vector<Profiler::Statistic> Profiler::Aggregate() const
+    {
+        std::unordered_map<std::string, Statistic> statistics;
+        for (const auto &frame : GetFrames())
+        {
+            for (const auto &event : frame.Events)
+            {
+                Statistic &statistic = statistics.try_emplace(event.Name, Statistic{event.Name, 0, 0, 0}).first->second;
+                statistic.Total += event.Duration;
+                statistic.Peak = std::max(statistic.Peak, event.Duration);
+                statistic.Calls++;
+            }
+        }
+        std::vector<Statistic> result;
+        for (auto &entry : statistics)
+        {
+            result.push_back(std::move(entry.second));
+        }
+        std::sort(result.begin(), result.end(), [](const Statistic &a, const Statistic &b)
+                  { return a.Total > b.Total; });
+        return result;
+    }
+
+    void Profiler::ExportChromeTrace(const std::string &path) const
+    {
+        std::ofstream stream(path);
+        if (!stream)
+        {
+            throw std::runtime_error("Failed to open profiler trace file.");
+        }
+        // Complete events ("ph":"X") with microsecond timestamps, nesting is
+        // derived from the time ranges per thread
+        stream << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+        bool first = true;
+        auto writeEvent = [&stream, &first](const std::string &name, const uint64_t &start, const uint64_t &duration, const uint32_t &thread)
+        {
+            stream << (first ? "" : ",") << "\n{\"name\":\"";
+            writeEscaped(stream, name);
+            stream << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread
+                   << ",\"ts\":" << start / 1000.0 << ",\"dur\":" << duration / 1000.0 << "}";
+            first = false;
+        };
+        for (const auto &frame : GetFrames())
+        {
+            writeEvent("Frame", frame.Start, frame.Duration, frame.Thread);
+            for (const auto &event : frame.Events)
+            {
+                writeEvent(event.Name, event.Start, event.Duration, event.Thread);
+            }
+        }
+        stream << "\n]}\n";
+        if (!stream)
+        {
+            throw std::runtime_error("Failed to write profiler trace file.");
+        }
+    }
+
+    uint64_t Profiler::Now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    const char *Profiler::TypeName(const std::type_info &type)
+    {
+        static std::mutex namesMutex;
+        static std::unordered_map<const std::type_info *, std::string> names;
+        std::lock_guard<std::mutex> lock(namesMutex);
+        auto it = names.find(&type);
+        if (it == names.end())
+        {
+            std::string name = type.name();
+#if defined(__GNUG__)
+            int status = 0;
+            char *demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+            if (status == 0 && demangled != nullptr)
+            {
+                name = demangled;
+            }
+            std::free(demangled);
+#endif
+            it = names.emplace(&type, std::move(name)).first;
+        }
+        return it->second.c_str();
+    }
+
+    Profiler &Profiler::Shared()
+    {
+        // Never destroyed, scopes may close during static destruction
+        static Profiler *profiler = new Profiler();
+        return *profiler;
+    }
+}
+
+#endif
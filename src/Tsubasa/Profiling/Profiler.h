@@ -0,0 +1,96 @@
+#pragma once
+
+#ifdef TSUBASA_PROFILE
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace Tsubasa
+{
+    // Collects nested CPU timing scopes from every thread, keeping the last
+    // FrameCapacity frames. Only built with TSUBASA_PROFILE, use the macros
+    // below so that call sites vanish otherwise.
+    class Profiler
+    {
+    public:
+        struct Event
+        {
+            const char *Name;
+            uint64_t Start;
+            uint64_t Duration;
+            uint32_t Thread;
+            uint32_t Depth;
+        };
+
+        struct Frame
+        {
+            uint64_t Start;
+            uint64_t Duration;
+            uint32_t Thread;
+            std::vector<Event> Events;
+        };
+
+        struct Statistic
+        {
+            std::string Name;
+            uint64_t Total;
+            uint64_t Peak;
+            uint32_t Calls;
+        };
+
+        class Scope
+        {
+        public:
+            Scope(const char *name);
+            ~Scope();
+
+        private:
+            const char *name;
+            uint64_t start;
+        };
+
+        Profiler();
+        ~Profiler();
+
+        void BeginFrame();
+        void EndFrame();
+        void Record(const char *name, const uint64_t &start, const uint64_t &end, const uint32_t &depth);
+        // Recorded frames, oldest first
+        std::vector<Frame> GetFrames() const;
+        // Time spent per scope name over the recorded frames, largest first
+        std::vector<Statistic> Aggregate() const;
+        void ExportChromeTrace(const std::string &path) const;
+
+        // Nanoseconds since the profiler was created
+        static uint64_t Now();
+        // Readable name of a type, kept alive for the lifetime of the program
+        static const char *TypeName(const std::type_info &type);
+        static Profiler &Shared();
+
+        static const size_t FrameCapacity;
+
+    private:
+        mutable std::mutex mutex;
+        std::vector<Frame> frames;
+        size_t current;
+        size_t recorded;
+    };
+}
+
+#define TSUBASA_PROFILE_JOIN_(a, b) a##b
+#define TSUBASA_PROFILE_JOIN(a, b) TSUBASA_PROFILE_JOIN_(a, b)
+#define TSUBASA_PROFILE_SCOPE(name) ::Tsubasa::Profiler::Scope TSUBASA_PROFILE_JOIN(profileScope, __LINE__)(name)
+#define TSUBASA_PROFILE_FRAME_BEGIN() ::Tsubasa::Profiler::Shared().BeginFrame()
+#define TSUBASA_PROFILE_FRAME_END() ::Tsubasa::Profiler::Shared().EndFrame()
+
+#else
+
+#define TSUBASA_PROFILE_SCOPE(name)
+#define TSUBASA_PROFILE_FRAME_BEGIN()
+#define TSUBASA_PROFILE_FRAME_END()
+
+#endif
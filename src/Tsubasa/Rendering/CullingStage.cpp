@@ -0,0 +1,48 @@
+#include <Tsubasa/Rendering/CullingStage.h>
+#include <Tsubasa/Application.h>
+#include <Tsubasa/Components/Camera.h>
+#include <Tsubasa/Components/MeshRenderer.h>
+#include <Tsubasa/Profiling/Profiler.h>
+
+namespace Tsubasa
+{
+    CullingStage::CullingStage() : Visible(visible), Submitted(submitted), Culled(culled)
+    {
+        submitted = 0;
+        culled = 0;
+    }
+
+    CullingStage::~CullingStage() {}
+
+    void CullingStage::Run(Application &client, const Camera &camera, const float &aspect)
+    {
+        TSUBASA_PROFILE_SCOPE("CullingStage::Run");
+        visible.clear();
+        const Frustum frustum = camera.GetFrustum(aspect);
+        const float alpha = client.Interpolation;
+        client.Spatial.Query(frustum, [&](const uint32_t &proxy, const SpatialIndex::Entry &spatialEntry)
+                             {
+            // Renderers removed or disabled since the index was updated are skipped
+            MeshRenderer *meshRenderer = static_cast<MeshRenderer *>(spatialEntry.Renderer.Get());
+            Node *entity = spatialEntry.Entity.Get();
+            if (meshRenderer == nullptr || entity == nullptr || !meshRenderer->Enabled || meshRenderer->RenderModel == nullptr)
+            {
+                return;
+            }
+            const Affine3x4 world = entity->GetInterpolatedTransform(alpha);
+            const Bounds bounds = meshRenderer->RenderModel->GetBounds().Transformed(world);
+            if (frustum.Intersects(bounds))
+            {
+                const float depth = frustum.Depth(bounds.Center);
+                const float screenSize = camera.GetScreenSize(depth + camera.NearPlane, bounds.GetRadius());
+                if (proxy >= levels.size())
+                {
+                    levels.resize(proxy + 1, 0);
+                }
+                levels[proxy] = meshRenderer->SelectLevel(screenSize, levels[proxy]);
+                visible.push_back({entity, meshRenderer, levels[proxy], meshRenderer->GetLevelModel(levels[proxy]), world, depth});
+            } });
+        submitted = client.Spatial.GetRendererCount();
+        culled = submitted - visible.size();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Tsubasa/Math/Affine3x4.h>
+#include <Tsubasa/Math/Frustum.h>
+#include <cstddef>
+#include <vector>
+
+namespace Tsubasa
+{
+    class Application;
+    class Camera;
+    class MeshRenderer;
+    class Model;
+    class Node;
+
+    // Collects the enabled MeshRenderers of an application whose model
+    // bounds, moved to the world, intersect a frustum. Candidates come from
+    // the application's SpatialIndex and are then tested with their
+    // interpolated transform. The level of detail of every visible renderer
+    // is picked here as well, and the stage remembers the levels it picked
+    // per spatial proxy, so each view with a stage of its own keeps its own
+    // hysteresis. Shared by the render systems, and free of any graphics
+    // calls so it also runs headless.
+    class CullingStage
+    {
+    public:
+        struct Entry
+        {
+            Node *Entity;
+            MeshRenderer *Renderer;
+            // Selected level of detail and its model
+            size_t Level;
+            const Model *RenderModel;
+            // Interpolated world transform, see Application::Interpolation
+            Affine3x4 Transform;
+            float Depth;
+        };
+
+        CullingStage();
+        ~CullingStage();
+
+        // The camera must be attached to a node
+        void Run(Application &client, const Camera &camera, const float &aspect);
+
+        // Renderers that passed, in no particular order
+        const std::vector<Entry> &Visible;
+        // Enabled renderers in the spatial index and those rejected by the
+        // last run
+        const size_t &Submitted;
+        const size_t &Culled;
+
+    private:
+        std::vector<Entry> visible;
+        // Level picked last time, by spatial proxy. A proxy reused by another
+        // renderer starts from the level of the previous one, which at most
+        // decides a pick inside the hysteresis margin.
+        std::vector<size_t> levels;
+        size_t submitted;
+        size_t culled;
+    };
+}
\ No newline at end of file
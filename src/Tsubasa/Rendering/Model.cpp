@@ -3,8 +3,11 @@
 
 namespace Tsubasa
 {
+    const int Model::DefaultDetail = 16;
+
     Model::Model(const MeshType &type)
     {
+        bounds = Bounds::Empty;
         if (type == MeshType::Custom)
         {
             model = std::make_shared<::Model>();
@@ -17,23 +20,28 @@ namespace Tsubasa
 
     Model::Model(const std::string &path)
     {
+        bounds = Bounds::Empty;
         Load(path);
     }
 
     Model::~Model() {}
 
-    void Model::Generate(const MeshType type)
+    void Model::Generate(const MeshType type, const int &detail)
     {
+        const bool upload = IsWindowReady();
         switch (type)
         {
         case MeshType::Cube:
-            model = std::make_shared<::Model>(LoadModelFromMesh(GenMeshCube(1.0f, 1.0f, 1.0f)));
+            model = upload ? std::make_shared<::Model>(LoadModelFromMesh(GenMeshCube(1.0f, 1.0f, 1.0f))) : std::make_shared<::Model>();
+            bounds = Bounds(Vector3::Zero, Vector3(0.5f, 0.5f, 0.5f));
             break;
         case MeshType::Sphere:
-            model = std::make_shared<::Model>(LoadModelFromMesh(GenMeshSphere(0.5f, 16, 16)));
+            model = upload ? std::make_shared<::Model>(LoadModelFromMesh(GenMeshSphere(0.5f, detail, detail))) : std::make_shared<::Model>();
+            bounds = Bounds(Vector3::Zero, Vector3(0.5f, 0.5f, 0.5f));
             break;
         case MeshType::Plane:
-            model = std::make_shared<::Model>(LoadModelFromMesh(GenMeshPlane(1.0f, 1.0f, 1, 1)));
+            model = upload ? std::make_shared<::Model>(LoadModelFromMesh(GenMeshPlane(1.0f, 1.0f, 1, 1))) : std::make_shared<::Model>();
+            bounds = Bounds(Vector3::Zero, Vector3(0.5f, 0.0f, 0.5f));
             break;
         default:
             break;
@@ -42,12 +50,27 @@ namespace Tsubasa
 
     bool Model::Load(const std::string &path)
     {
+        if (!IsWindowReady())
+        {
+            model = std::make_shared<::Model>();
+            bounds = Bounds::Empty;
+            return false;
+        }
         model = std::make_shared<::Model>(LoadModel(path.c_str()));
+        BoundingBox box = GetModelBoundingBox(*model);
+        bounds = Bounds::FromMinMax(Vector3(box.min.x, box.min.y, box.min.z), Vector3(box.max.x, box.max.y, box.max.z));
         return model != nullptr;
     }
 
-    std::shared_ptr<Model> Model::FromPrimitive(const MeshType &type)
+    const Bounds &Model::GetBounds() const
+    {
+        return bounds;
+    }
+
+    std::shared_ptr<Model> Model::FromPrimitive(const MeshType &type, const int &detail)
     {
-        return std::make_shared<Model>(type);
+        std::shared_ptr<Model> model = std::make_shared<Model>();
+        model->Generate(type, detail);
+        return model;
     }
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Tsubasa/Math/Bounds.h>
 #include <memory>
 #include <string>
 
@@ -15,6 +16,9 @@ namespace Tsubasa
         Custom
     };
 
+    // Meshes are uploaded to the GPU, so they are only created once a window
+    // exists. Without one, as in headless runs, a model stays empty but keeps
+    // the bounds of its primitive for culling.
     class Model
     {
         friend class MeshRenderer;
@@ -24,11 +28,19 @@ namespace Tsubasa
         Model(const std::string &path);
         ~Model();
 
-        void Generate(const MeshType type);
+        // Detail is the tessellation of curved primitives, the rings and
+        // slices of a sphere, cubes and planes ignore it
+        void Generate(const MeshType type, const int &detail = DefaultDetail);
         bool Load(const std::string &path);
 
-        static std::shared_ptr<Model> FromPrimitive(const MeshType &type);
+        // Local box enclosing every mesh, computed when generated or loaded
+        const Bounds &GetBounds() const;
+
+        static std::shared_ptr<Model> FromPrimitive(const MeshType &type, const int &detail = DefaultDetail);
+
+        static const int DefaultDetail;
     private:
         std::shared_ptr<::Model> model;
+        Bounds bounds;
     };
 }
\ No newline at end of file
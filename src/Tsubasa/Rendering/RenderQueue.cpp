@@ -0,0 +1,82 @@
+#include <Tsubasa/Rendering/RenderQueue.h>
+#include <Tsubasa/Profiling/Profiler.h>
+#include <algorithm>
+#include <cstring>
+
+namespace Tsubasa
+{
+    namespace
+    {
+        const uint64_t TransparentBit = 1ull << 63;
+
+        // The bits of a positive float grow with its value, the top 16 of
+        // its 31 keep the exponent and 8 bits of mantissa
+        uint64_t quantizeDepth(const float &depth)
+        {
+            if (!(depth > 0.0f))
+            {
+                return 0;
+            }
+            uint32_t bits;
+            std::memcpy(&bits, &depth, sizeof(bits));
+            return bits >> 15;
+        }
+    }
+
+    RenderQueue::RenderQueue() {}
+
+    RenderQueue::~RenderQueue() {}
+
+    void RenderQueue::Clear()
+    {
+        items.clear();
+        order.clear();
+        stateIds.clear();
+    }
+
+    void RenderQueue::Add(const uint64_t &key, const Model *model, const int &mesh, const Affine3x4 &transform)
+    {
+        order.push_back({key, static_cast<uint32_t>(items.size())});
+        items.push_back({key, model, mesh, transform});
+    }
+
+    void RenderQueue::Sort()
+    {
+        TSUBASA_PROFILE_SCOPE("RenderQueue::Sort");
+        // Only the small entries move, the index breaks ties to keep the sort stable
+        std::sort(order.begin(), order.end(), [](const SortEntry &a, const SortEntry &b)
+                  { return a.Key < b.Key || (a.Key == b.Key && a.Index < b.Index); });
+    }
+
+    size_t RenderQueue::GetSize() const
+    {
+        return order.size();
+    }
+
+    const RenderQueue::Item &RenderQueue::operator[](const size_t &index) const
+    {
+        return items[order[index].Index];
+    }
+
+    uint32_t RenderQueue::GetStateId(const void *state)
+    {
+        return stateIds.try_emplace(state, static_cast<uint32_t>(stateIds.size())).first->second;
+    }
+
+    uint64_t RenderQueue::MakeKey(const bool &transparent, const uint32_t &shader, const uint32_t &material, const uint32_t &mesh, const float &depth)
+    {
+        // Opaque:      0 | shader 15 | material 16 | mesh 16 | depth 16
+        // Transparent: 1 | inverted depth 16 | shader 15 | material 16 | mesh 16
+        const uint64_t state = (uint64_t)(shader & 0x7FFF) << 32 | (uint64_t)(material & 0xFFFF) << 16 | (mesh & 0xFFFF);
+        if (transparent)
+        {
+            return TransparentBit | (0xFFFF - quantizeDepth(depth)) << 47 | state;
+        }
+        return state << 16 | quantizeDepth(depth);
+    }
+
+    bool RenderQueue::IsTransparent(const uint64_t &key)
+    {
+        return (key & TransparentBit) != 0;
+    }
+}
\ No newline at end of file
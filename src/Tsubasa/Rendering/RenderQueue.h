@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Tsubasa/Math/Affine3x4.h>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Tsubasa
+{
+    class Model;
+
+    // Draw items ordered by a 64 bit sort key. Opaque keys hold the shader,
+    // material and mesh above the depth, so items sharing state end up next
+    // to each other and are drawn front to back within a group. Transparent
+    // keys sort after every opaque one and hold the inverted depth first, so
+    // they are drawn back to front.
+    class RenderQueue
+    {
+    public:
+        struct Item
+        {
+            uint64_t Key;
+            const Model *RenderModel;
+            int Mesh;
+            Affine3x4 Transform;
+        };
+
+        RenderQueue();
+        ~RenderQueue();
+
+        void Clear();
+        void Add(const uint64_t &key, const Model *model, const int &mesh, const Affine3x4 &transform);
+        // Orders the items by key, equal keys keep the order they were added in
+        void Sort();
+
+        size_t GetSize() const;
+        // Item at a position of the sorted order
+        const Item &operator[](const size_t &index) const;
+
+        // Small dense id for a state object like a material or mesh, stable
+        // until the next Clear()
+        uint32_t GetStateId(const void *state);
+
+        static uint64_t MakeKey(const bool &transparent, const uint32_t &shader, const uint32_t &material, const uint32_t &mesh, const float &depth);
+        static bool IsTransparent(const uint64_t &key);
+
+    private:
+        struct SortEntry
+        {
+            uint64_t Key;
+            uint32_t Index;
+        };
+
+        std::vector<Item> items;
+        std::vector<SortEntry> order;
+        std::unordered_map<const void *, uint32_t> stateIds;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Tsubasa
+{
+    // Non-owning view of a contiguous run of elements
+    template <typename T>
+    class Span
+    {
+    public:
+        Span() : data(nullptr), size(0) {}
+        Span(T *data, const size_t &size) : data(data), size(size) {}
+        template <typename Container, typename = std::enable_if_t<std::is_convertible_v<decltype(std::declval<Container &>().data()), T *>>>
+        Span(Container &container) : data(container.data()), size(container.size()) {}
+
+        T *begin() const
+        {
+            return data;
+        }
+        T *end() const
+        {
+            return data + size;
+        }
+        T &operator[](const size_t &index) const
+        {
+            return data[index];
+        }
+        T *Data() const
+        {
+            return data;
+        }
+        size_t Size() const
+        {
+            return size;
+        }
+        bool Empty() const
+        {
+            return size == 0;
+        }
+
+    private:
+        T *data;
+        size_t size;
+    };
+}
@@ -0,0 +1,244 @@
+#include <Tsubasa/Spatial/BoundingVolumeTree.h>
+#include <algorithm>
+
+namespace Tsubasa
+{
+    const uint32_t BoundingVolumeTree::Invalid = UINT32_MAX;
+
+    BoundingVolumeTree::BoundingVolumeTree()
+    {
+        Margin = 0.1f;
+        root = Invalid;
+        freeList = Invalid;
+        proxyCount = 0;
+    }
+
+    BoundingVolumeTree::~BoundingVolumeTree() {}
+
+    uint32_t BoundingVolumeTree::Insert(const Bounds &bounds)
+    {
+        const uint32_t proxy = allocateNode();
+        nodes[proxy].Box = bounds.Expanded(Margin);
+        nodes[proxy].Height = 0;
+        insertLeaf(proxy);
+        proxyCount++;
+        return proxy;
+    }
+
+    void BoundingVolumeTree::Remove(const uint32_t &proxy)
+    {
+        removeLeaf(proxy);
+        freeNode(proxy);
+        proxyCount--;
+    }
+
+    bool BoundingVolumeTree::Move(const uint32_t &proxy, const Bounds &bounds)
+    {
+        // Also reinserted when the grown box became much larger than needed,
+        // as after a fast object came to rest
+        const Bounds &box = nodes[proxy].Box;
+        if (box.Contains(bounds) && bounds.Expanded(4.0f * Margin).Contains(box))
+        {
+            return false;
+        }
+        removeLeaf(proxy);
+        nodes[proxy].Box = bounds.Expanded(Margin);
+        insertLeaf(proxy);
+        return true;
+    }
+
+    void BoundingVolumeTree::Clear()
+    {
+        nodes.clear();
+        root = Invalid;
+        freeList = Invalid;
+        proxyCount = 0;
+    }
+
+    const Bounds &BoundingVolumeTree::GetBounds(const uint32_t &proxy) const
+    {
+        return nodes[proxy].Box;
+    }
+
+    size_t BoundingVolumeTree::GetProxyCount() const
+    {
+        return proxyCount;
+    }
+
+    int BoundingVolumeTree::GetHeight() const
+    {
+        return root == Invalid ? 0 : nodes[root].Height;
+    }
+
+    uint32_t BoundingVolumeTree::allocateNode()
+    {
+        uint32_t index;
+        if (freeList != Invalid)
+        {
+            index = freeList;
+            freeList = nodes[index].Parent;
+        }
+        else
+        {
+            index = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+        TreeNode &node = nodes[index];
+        node.Parent = Invalid;
+        node.Children[0] = Invalid;
+        node.Children[1] = Invalid;
+        node.Height = 0;
+        return index;
+    }
+
+    void BoundingVolumeTree::freeNode(const uint32_t &index)
+    {
+        nodes[index].Parent = freeList;
+        nodes[index].Height = -1;
+        freeList = index;
+    }
+
+    void BoundingVolumeTree::insertLeaf(const uint32_t &leaf)
+    {
+        if (root == Invalid)
+        {
+            root = leaf;
+            nodes[leaf].Parent = Invalid;
+            return;
+        }
+        // Walk down to the sibling whose pairing grows the tree's surface area
+        // the least. Every ancestor of the new pair grows by the same amount,
+        // which is the inherited cost of descending.
+        const Bounds box = nodes[leaf].Box;
+        uint32_t index = root;
+        while (!nodes[index].IsLeaf())
+        {
+            const TreeNode &node = nodes[index];
+            const float area = node.Box.GetSurfaceArea();
+            const float mergedArea = node.Box.Merged(box).GetSurfaceArea();
+            const float cost = 2.0f * mergedArea;
+            const float inherited = 2.0f * (mergedArea - area);
+            float childCosts[2];
+            for (int i = 0; i < 2; i++)
+            {
+                const TreeNode &child = nodes[node.Children[i]];
+                const float grown = child.Box.Merged(box).GetSurfaceArea();
+                childCosts[i] = (child.IsLeaf() ? grown : grown - child.Box.GetSurfaceArea()) + inherited;
+            }
+            if (cost < childCosts[0] && cost < childCosts[1])
+            {
+                break;
+            }
+            index = childCosts[0] < childCosts[1] ? node.Children[0] : node.Children[1];
+        }
+
+        // Pair the leaf with the sibling under a new parent
+        const uint32_t sibling = index;
+        const uint32_t newParent = allocateNode();
+        const uint32_t oldParent = nodes[sibling].Parent;
+        nodes[newParent].Parent = oldParent;
+        nodes[newParent].Box = box.Merged(nodes[sibling].Box);
+        nodes[newParent].Height = nodes[sibling].Height + 1;
+        nodes[newParent].Children[0] = sibling;
+        nodes[newParent].Children[1] = leaf;
+        nodes[sibling].Parent = newParent;
+        nodes[leaf].Parent = newParent;
+        if (oldParent == Invalid)
+        {
+            root = newParent;
+        }
+        else
+        {
+            TreeNode &parent = nodes[oldParent];
+            parent.Children[parent.Children[0] == sibling ? 0 : 1] = newParent;
+        }
+        refit(nodes[leaf].Parent);
+    }
+
+    void BoundingVolumeTree::removeLeaf(const uint32_t &leaf)
+    {
+        if (leaf == root)
+        {
+            root = Invalid;
+            return;
+        }
+        // The sibling takes the place of the parent
+        const uint32_t parent = nodes[leaf].Parent;
+        const uint32_t grandParent = nodes[parent].Parent;
+        const uint32_t sibling = nodes[parent].Children[nodes[parent].Children[0] == leaf ? 1 : 0];
+        nodes[sibling].Parent = grandParent;
+        freeNode(parent);
+        nodes[leaf].Parent = Invalid;
+        if (grandParent == Invalid)
+        {
+            root = sibling;
+        }
+        else
+        {
+            TreeNode &node = nodes[grandParent];
+            node.Children[node.Children[0] == parent ? 0 : 1] = sibling;
+            refit(grandParent);
+        }
+    }
+
+    void BoundingVolumeTree::refit(uint32_t index)
+    {
+        while (index != Invalid)
+        {
+            index = balance(index);
+            TreeNode &node = nodes[index];
+            const TreeNode &first = nodes[node.Children[0]];
+            const TreeNode &second = nodes[node.Children[1]];
+            node.Height = 1 + std::max(first.Height, second.Height);
+            node.Box = first.Box.Merged(second.Box);
+            index = node.Parent;
+        }
+    }
+
+    uint32_t BoundingVolumeTree::balance(const uint32_t &index)
+    {
+        // When one child of a is more than one level taller, that child is
+        // rotated up into a's place, and a keeps the shorter grandchild
+        TreeNode &a = nodes[index];
+        if (a.IsLeaf() || a.Height < 2)
+        {
+            return index;
+        }
+        const int32_t difference = nodes[a.Children[1]].Height - nodes[a.Children[0]].Height;
+        if (difference >= -1 && difference <= 1)
+        {
+            return index;
+        }
+        const int tall = difference > 1 ? 1 : 0;
+        const uint32_t up = a.Children[tall];
+        const uint32_t other = a.Children[1 - tall];
+        TreeNode &b = nodes[up];
+        const uint32_t first = b.Children[0];
+        const uint32_t second = b.Children[1];
+
+        b.Children[0] = index;
+        b.Parent = a.Parent;
+        a.Parent = up;
+        if (b.Parent == Invalid)
+        {
+            root = up;
+        }
+        else
+        {
+            TreeNode &parent = nodes[b.Parent];
+            parent.Children[parent.Children[0] == index ? 0 : 1] = up;
+        }
+
+        const bool firstTaller = nodes[first].Height > nodes[second].Height;
+        const uint32_t kept = firstTaller ? first : second;
+        const uint32_t moved = firstTaller ? second : first;
+        b.Children[1] = kept;
+        a.Children[tall] = moved;
+        nodes[moved].Parent = index;
+        a.Box = nodes[other].Box.Merged(nodes[moved].Box);
+        a.Height = 1 + std::max(nodes[other].Height, nodes[moved].Height);
+        b.Box = a.Box.Merged(nodes[kept].Box);
+        b.Height = 1 + std::max(a.Height, nodes[kept].Height);
+        return up;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <Tsubasa/Math/Bounds.h>
+#include <Tsubasa/Math/Frustum.h>
+#include <Tsubasa/Math/Ray.h>
+#include <Tsubasa/Math/Vector3.h>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace Tsubasa
+{
+    // Dynamic tree of axis-aligned boxes. Each leaf is a proxy whose box is
+    // grown by Margin, so small moves leave the tree untouched and a proxy is
+    // only reinserted once it escapes its grown box. Inserts choose the
+    // sibling by surface area, and rotations on the way back up keep the
+    // tree balanced. Proxy ids stay valid until removed.
+    class BoundingVolumeTree
+    {
+    public:
+        BoundingVolumeTree();
+        ~BoundingVolumeTree();
+
+        uint32_t Insert(const Bounds &bounds);
+        void Remove(const uint32_t &proxy);
+        // Returns whether the proxy had to be reinserted
+        bool Move(const uint32_t &proxy, const Bounds &bounds);
+        void Clear();
+
+        // Grown box of a proxy
+        const Bounds &GetBounds(const uint32_t &proxy) const;
+        size_t GetProxyCount() const;
+        // Longest path from the root to a leaf
+        int GetHeight() const;
+
+        // Call callback(uint32_t proxy) for every proxy whose grown box
+        // overlaps the shape. The tree must not change during a query.
+        template <typename Callback>
+        void Query(const Bounds &bounds, const Callback &callback) const;
+        template <typename Callback>
+        void Query(const Vector3 &center, const float &radius, const Callback &callback) const;
+        template <typename Callback>
+        void Query(const Frustum &frustum, const Callback &callback) const;
+        // Calls callback(uint32_t proxy) for the proxies the ray reaches. It
+        // returns the distance the ray is clipped to from then on, so a
+        // nearest hit query returns the distance of each hit, and 0 ends the
+        // cast.
+        template <typename Callback>
+        void Raycast(const Ray &ray, const float &maxDistance, const Callback &callback) const;
+
+        // Room around each proxy before a move reinserts it
+        float Margin;
+
+        static const uint32_t Invalid;
+
+    private:
+        struct TreeNode
+        {
+            Bounds Box;
+            // Next free node while unused
+            uint32_t Parent;
+            uint32_t Children[2];
+            // 0 for leaves, -1 for free nodes
+            int32_t Height;
+
+            bool IsLeaf() const
+            {
+                return Children[0] == Invalid;
+            }
+        };
+
+        // Balanced trees stay far below this depth
+        static constexpr int StackSize = 256;
+
+        std::vector<TreeNode> nodes;
+        uint32_t root;
+        uint32_t freeList;
+        size_t proxyCount;
+
+        uint32_t allocateNode();
+        void freeNode(const uint32_t &index);
+        void insertLeaf(const uint32_t &leaf);
+        void removeLeaf(const uint32_t &leaf);
+        void refit(uint32_t index);
+        uint32_t balance(const uint32_t &index);
+        template <typename Overlaps, typename Callback>
+        void query(const Overlaps &overlaps, const Callback &callback) const;
+    };
+
+    template <typename Callback>
+    void BoundingVolumeTree::Query(const Bounds &bounds, const Callback &callback) const
+    {
+        query([&bounds](const Bounds &box)
+              { return box.Intersects(bounds); },
+              callback);
+    }
+
+    template <typename Callback>
+    void BoundingVolumeTree::Query(const Vector3 &center, const float &radius, const Callback &callback) const
+    {
+        query([&center, &radius](const Bounds &box)
+              { return box.Intersects(center, radius); },
+              callback);
+    }
+
+    template <typename Callback>
+    void BoundingVolumeTree::Query(const Frustum &frustum, const Callback &callback) const
+    {
+        query([&frustum](const Bounds &box)
+              { return frustum.Intersects(box); },
+              callback);
+    }
+
+    template <typename Callback>
+    void BoundingVolumeTree::Raycast(const Ray &ray, const float &maxDistance, const Callback &callback) const
+    {
+        float distance = maxDistance;
+        query([&ray, &distance](const Bounds &box)
+              {
+            float entry;
+            return distance > 0.0f && box.Raycast(ray, distance, entry); },
+              [&callback, &distance](const uint32_t &proxy)
+              { distance = callback(proxy); });
+    }
+
+    template <typename Overlaps, typename Callback>
+    void BoundingVolumeTree::query(const Overlaps &overlaps, const Callback &callback) const
+    {
+        if (root == Invalid)
+        {
+            return;
+        }
+        uint32_t stack[StackSize];
+        int count = 0;
+        stack[count++] = root;
+        while (count > 0)
+        {
+            const uint32_t index = stack[--count];
+            const TreeNode &node = nodes[index];
+            if (!overlaps(node.Box))
+            {
+                continue;
+            }
+            if (node.IsLeaf())
+            {
+                callback(index);
+            }
+            else
+            {
+                if (count + 2 > StackSize)
+                {
+                    throw std::runtime_error("Bounding volume tree is too deep to query.");
+                }
+                stack[count++] = node.Children[0];
+                stack[count++] = node.Children[1];
+            }
+        }
+    }
+}
\ No newline at end of file
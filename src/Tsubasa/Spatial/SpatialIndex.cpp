@@ -0,0 +1,223 @@
+#include <Tsubasa/Spatial/SpatialIndex.h>
+#include <Tsubasa/Application.h>
+#include <Tsubasa/Components/MeshRenderer.h>
+#include <Tsubasa/Profiling/Profiler.h>
+#include <Tsubasa/TransformStore.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Tsubasa
+{
+    SpatialIndex::SpatialIndex() : Tree(tree), Refitted(refitted)
+    {
+        stamp = 0;
+        revision = UINT64_MAX;
+        refitted = 0;
+    }
+
+    SpatialIndex::~SpatialIndex() {}
+
+    uint32_t SpatialIndex::Register(const Bounds &bounds, void *userData)
+    {
+        const uint32_t proxy = insert(bounds);
+        entries[proxy].UserData = userData;
+        return proxy;
+    }
+
+    void SpatialIndex::Move(const uint32_t &proxy, const Bounds &bounds)
+    {
+        entries[proxy].WorldBounds = bounds;
+        tree.Move(proxy, bounds);
+    }
+
+    void SpatialIndex::Unregister(const uint32_t &proxy)
+    {
+        remove(proxy);
+    }
+
+    void SpatialIndex::Update(Application &client)
+    {
+        TSUBASA_PROFILE_SCOPE("SpatialIndex::Update");
+        refitted = 0;
+        // Taken every frame, so the log never builds up
+        const bool complete = TransformStore::Shared().TakeMoved(&client, moved);
+        const ComponentStorage &storage = ComponentRegistry::Shared().Storage<MeshRenderer>();
+        if (!complete || storage.Revision != revision)
+        {
+            revision = storage.Revision;
+            rescan(client);
+            return;
+        }
+        for (const auto &root : moved)
+        {
+            Node *node = root.Get();
+            if (node == nullptr || node->Client != &client)
+            {
+                continue;
+            }
+            node->Traverse([this](Node &entity)
+                           {
+                if (!entity.HasComponent<MeshRenderer>())
+                {
+                    return;
+                }
+                for (const auto &component : entity.components)
+                {
+                    auto it = renderers.find(component.get());
+                    if (it != renderers.end())
+                    {
+                        refit(entity, static_cast<MeshRenderer &>(*component), it->second, false);
+                    }
+                } });
+        }
+    }
+
+    void SpatialIndex::Invalidate()
+    {
+        revision = UINT64_MAX;
+    }
+
+    void SpatialIndex::Clear()
+    {
+        tree.Clear();
+        entries.clear();
+        renderers.clear();
+        revision = UINT64_MAX;
+        refitted = 0;
+    }
+
+    const SpatialIndex::Entry &SpatialIndex::GetEntry(const uint32_t &proxy) const
+    {
+        return entries[proxy];
+    }
+
+    size_t SpatialIndex::GetRendererCount() const
+    {
+        return renderers.size();
+    }
+
+    bool SpatialIndex::Raycast(const Ray &ray, const float &maxDistance, RaycastHit &hit) const
+    {
+        hit.Proxy = BoundingVolumeTree::Invalid;
+        hit.Distance = maxDistance;
+        tree.Raycast(ray, maxDistance, [this, &ray, &hit](const uint32_t &proxy)
+                     {
+            float distance;
+            if (entries[proxy].WorldBounds.Raycast(ray, hit.Distance, distance))
+            {
+                hit.Proxy = proxy;
+                hit.Distance = distance;
+            }
+            return hit.Distance; });
+        return hit.Proxy != BoundingVolumeTree::Invalid;
+    }
+
+    void SpatialIndex::rescan(Application &client)
+    {
+        stamp++;
+        size_t seen = 0;
+        client.Query<MeshRenderer>([&](Node &entity, MeshRenderer &renderer)
+                                   {
+            if (!renderer.Enabled || renderer.RenderModel == nullptr)
+            {
+                return;
+            }
+            seen++;
+            auto result = renderers.try_emplace(&renderer);
+            result.first->second.Stamp = stamp;
+            refit(entity, renderer, result.first->second, result.second); });
+        // Renderers not seen were destroyed, disabled or moved to another application
+        if (seen != renderers.size())
+        {
+            for (auto it = renderers.begin(); it != renderers.end();)
+            {
+                if (it->second.Stamp != stamp)
+                {
+                    remove(it->second.Proxy);
+                    it = renderers.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    void SpatialIndex::refit(Node &entity, MeshRenderer &renderer, Tracked &tracked, const bool &inserted)
+    {
+        const uint32_t version = TransformStore::Shared().Versions[entity.transformIndex];
+        // A renderer allocated where a destroyed one lived takes over its proxy
+        const bool replaced = !inserted && tracked.Handle.Get() != &renderer;
+        if (inserted)
+        {
+            tracked.Proxy = insert(rendererBounds(entity, renderer));
+        }
+        else if (replaced || tracked.Version != version || tracked.RenderModel != renderer.RenderModel.get())
+        {
+            Move(tracked.Proxy, rendererBounds(entity, renderer));
+        }
+        else
+        {
+            return;
+        }
+        refitted++;
+        tracked.Handle = renderer.GetHandle();
+        tracked.RenderModel = renderer.RenderModel.get();
+        tracked.Version = version;
+        Entry &entry = entries[tracked.Proxy];
+        entry.Entity = entity.GetHandle();
+        entry.Renderer = tracked.Handle;
+    }
+
+    uint32_t SpatialIndex::insert(const Bounds &bounds)
+    {
+        const uint32_t proxy = tree.Insert(bounds);
+        if (proxy >= entries.size())
+        {
+            entries.resize(proxy + 1);
+        }
+        entries[proxy] = {bounds, nullptr, nullptr, nullptr};
+        return proxy;
+    }
+
+    void SpatialIndex::remove(const uint32_t &proxy)
+    {
+        tree.Remove(proxy);
+        entries[proxy] = {Bounds::Empty, nullptr, nullptr, nullptr};
+    }
+
+    Bounds SpatialIndex::rendererBounds(Node &entity, const MeshRenderer &renderer)
+    {
+        const Bounds &local = renderer.RenderModel->GetBounds();
+        const Affine3x4 current = entity.GetTransform();
+        const Affine3x4 previous = entity.GetInterpolatedTransform(0.0f);
+        Bounds bounds = local.Transformed(current);
+        if (std::equal(current.m, current.m + 12, previous.m))
+        {
+            return bounds;
+        }
+        // Interpolation moves the origin and scale linearly but turns along
+        // the arc, so a sphere about the origin, as large as the model
+        // stretched by either transform, covers every frame until the next
+        // step
+        const float reach = local.Center.Magnitude() + local.GetRadius();
+        for (const Affine3x4 *transform : {&current, &previous})
+        {
+            // Sum of the squared linear elements, never below the squared
+            // largest stretch
+            float stretch = 0.0f;
+            for (int row = 0; row < 3; row++)
+            {
+                for (int column = 0; column < 3; column++)
+                {
+                    const float element = transform->m[row * 4 + column];
+                    stretch += element * element;
+                }
+            }
+            const float radius = reach * sqrtf(stretch);
+            bounds = bounds.Merged(Bounds(transform->GetTranslation(), Vector3(radius, radius, radius)));
+        }
+        return bounds;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <Tsubasa/Handle.h>
+#include <Tsubasa/Math/Bounds.h>
+#include <Tsubasa/Math/Frustum.h>
+#include <Tsubasa/Math/Ray.h>
+#include <Tsubasa/Math/Vector3.h>
+#include <Tsubasa/Spatial/BoundingVolumeTree.h>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Tsubasa
+{
+    class Application;
+    class Component;
+    class MeshRenderer;
+    class Model;
+    class Node;
+
+    // World bounds of the enabled MeshRenderers of an application, plus any
+    // bounds registered by hand, in a BoundingVolumeTree. Update() walks
+    // the subtrees of the application the TransformStore recomputed since
+    // the last call, from the log the store keeps for that application, and
+    // refits the renderers found there, so its cost follows what moved. It
+    // only rescans every renderer when the MeshRenderer storage changed, for
+    // renderers added, removed, enabled, disabled or given a new model, or
+    // when the store dropped its log of moved subtrees. Application::Run()
+    // calls it right after the transform update.
+    class SpatialIndex
+    {
+    public:
+        struct Entry
+        {
+            // Tight world box, for renderers it also covers the interpolated
+            // motion of the last fixed step
+            Bounds WorldBounds;
+            // Set for renderers, resolve to nullptr once they are destroyed
+            NodeHandle Entity;
+            ComponentHandle Renderer;
+            // As given to Register(), nullptr for renderers
+            void *UserData;
+        };
+
+        struct RaycastHit
+        {
+            uint32_t Proxy;
+            float Distance;
+        };
+
+        SpatialIndex();
+        ~SpatialIndex();
+
+        // Bounds managed by the caller, kept until unregistered
+        uint32_t Register(const Bounds &bounds, void *userData = nullptr);
+        void Move(const uint32_t &proxy, const Bounds &bounds);
+        void Unregister(const uint32_t &proxy);
+
+        void Update(Application &client);
+        // Makes the next Update() rescan every renderer
+        void Invalidate();
+        void Clear();
+
+        const Entry &GetEntry(const uint32_t &proxy) const;
+        size_t GetRendererCount() const;
+
+        // Call callback(uint32_t proxy, const Entry &entry) for every entry
+        // whose tight bounds overlap the shape
+        template <typename Callback>
+        void Query(const Bounds &bounds, const Callback &callback) const;
+        template <typename Callback>
+        void Query(const Vector3 &center, const float &radius, const Callback &callback) const;
+        template <typename Callback>
+        void Query(const Frustum &frustum, const Callback &callback) const;
+        // Nearest entry hit within maxDistance
+        bool Raycast(const Ray &ray, const float &maxDistance, RaycastHit &hit) const;
+
+        const BoundingVolumeTree &Tree;
+        // Renderers inserted or moved by the last Update()
+        const size_t &Refitted;
+
+    private:
+        struct Tracked
+        {
+            ComponentHandle Handle;
+            const Model *RenderModel;
+            uint32_t Proxy;
+            uint32_t Version;
+            uint64_t Stamp;
+        };
+
+        BoundingVolumeTree tree;
+        std::vector<Entry> entries;
+        std::unordered_map<const Component *, Tracked> renderers;
+        std::vector<NodeHandle> moved;
+        uint64_t stamp;
+        uint64_t revision;
+        size_t refitted;
+
+        void rescan(Application &client);
+        void refit(Node &entity, MeshRenderer &renderer, Tracked &tracked, const bool &inserted);
+        uint32_t insert(const Bounds &bounds);
+        void remove(const uint32_t &proxy);
+        static Bounds rendererBounds(Node &entity, const MeshRenderer &renderer);
+    };
+
+    template <typename Callback>
+    void SpatialIndex::Query(const Bounds &bounds, const Callback &callback) const
+    {
+        tree.Query(bounds, [this, &bounds, &callback](const uint32_t &proxy)
+                   {
+            if (entries[proxy].WorldBounds.Intersects(bounds))
+            {
+                callback(proxy, entries[proxy]);
+            } });
+    }
+
+    template <typename Callback>
+    void SpatialIndex::Query(const Vector3 &center, const float &radius, const Callback &callback) const
+    {
+        tree.Query(center, radius, [this, &center, &radius, &callback](const uint32_t &proxy)
+                   {
+            if (entries[proxy].WorldBounds.Intersects(center, radius))
+            {
+                callback(proxy, entries[proxy]);
+            } });
+    }
+
+    template <typename Callback>
+    void SpatialIndex::Query(const Frustum &frustum, const Callback &callback) const
+    {
+        tree.Query(frustum, [this, &frustum, &callback](const uint32_t &proxy)
+                   {
+            if (frustum.Intersects(entries[proxy].WorldBounds))
+            {
+                callback(proxy, entries[proxy]);
+            } });
+    }
+}
\ No newline at end of file
@@ -1,9 +1,17 @@
 #include <Tsubasa/System.h>
 #include <Tsubasa/Application.h>
+#include <stdexcept>
 
 namespace Tsubasa
 {
-    System::System() : Client(application) {}
+    System::System() : Client(application)
+    {
+        application = nullptr;
+        typeId = 0;
+        transforms = false;
+        structural = false;
+        declared = false;
+    }
 
     System::~System() {}
 
@@ -14,5 +22,57 @@ namespace Tsubasa
         return true;
     }
 
+    void System::OnFixedUpdate(float timeStep) {}
+
     void System::OnExit() {}
+
+    JobSystem *System::GetJobSystem() const
+    {
+        return application != nullptr ? &application->Jobs : nullptr;
+    }
+
+    bool System::IsExclusive() const
+    {
+        return !declared || structural;
+    }
+
+    bool System::ConflictsWith(const System &other) const
+    {
+        if (IsExclusive() || other.IsExclusive() || (transforms && other.transforms))
+        {
+            return true;
+        }
+        return (writes & (other.reads | other.writes)).any() || (reads & other.writes).any();
+    }
+
+    void System::declare(ComponentMask &mask, const uint32_t &componentTypeId)
+    {
+        if (componentTypeId >= MaxComponentTypes)
+        {
+            throw std::runtime_error("Too many component types.");
+        }
+        mask.set(componentTypeId);
+        markDeclared();
+    }
+
+    void System::UsesTransforms()
+    {
+        transforms = true;
+        markDeclared();
+    }
+
+    void System::ChangesStructure()
+    {
+        structural = true;
+        markDeclared();
+    }
+
+    void System::markDeclared()
+    {
+        declared = true;
+        if (application != nullptr)
+        {
+            application->scheduleValid = false;
+        }
+    }
 }
\ No newline at end of file
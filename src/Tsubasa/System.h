@@ -1,10 +1,17 @@
 #pragma once
 
+#include <Tsubasa/ComponentRegistry.h>
+#include <Tsubasa/TypeId.h>
+#include <cstdint>
 #include <memory>
 
 namespace Tsubasa
 {
     class Application;
+    class JobSystem;
+    class System;
+
+    using SystemTypeId = TypeId<System>;
 
     class System
     {
@@ -15,11 +22,52 @@ namespace Tsubasa
 
         virtual void OnInit();
         virtual bool OnUpdate(float timeDelta);
+        virtual void OnFixedUpdate(float timeStep);
         virtual void OnExit();
 
-        const std::shared_ptr<Application> &Client;
+        // Job system of the owning application, or nullptr when detached
+        JobSystem *GetJobSystem() const;
+
+        // A system that declared no access, or structural changes, runs alone
+        // on the main thread
+        bool IsExclusive() const;
+        bool ConflictsWith(const System &other) const;
+
+        // Owning application, which keeps its systems alive
+        Application *const &Client;
+
+    protected:
+        // Declare the component types OnUpdate reads or writes, so that
+        // systems without conflicting access can run concurrently on job
+        // workers. Call them from the constructor or OnInit.
+        template <typename T>
+        void Reads()
+        {
+            declare(reads, ComponentTypeId::Of<T>());
+        }
+        template <typename T>
+        void Writes()
+        {
+            declare(writes, ComponentTypeId::Of<T>());
+        }
+        // Declare that OnUpdate moves nodes or reads their world transforms.
+        // Reading resolves stale worlds into the shared transform store, so
+        // two systems using transforms always conflict.
+        void UsesTransforms();
+        // Declare that OnUpdate creates or destroys nodes or components, which
+        // touches the handle tables and pools every other system relies on
+        void ChangesStructure();
 
     private:
-        std::shared_ptr<Application> application;
+        Application *application;
+        uint32_t typeId;
+        ComponentMask reads;
+        ComponentMask writes;
+        bool transforms;
+        bool structural;
+        bool declared;
+
+        void declare(ComponentMask &mask, const uint32_t &componentTypeId);
+        void markDeclared();
     };
 }
\ No newline at end of file
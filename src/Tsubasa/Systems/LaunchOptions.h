@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+
+namespace Tsubasa
+{
+    struct LaunchOptions
+    {
+        int ScreenWidth;
+        int ScreenHeight;
+        std::string WindowTitle;
+        bool Fullscreen;
+        bool VSync;
+    };
+}
\ No newline at end of file
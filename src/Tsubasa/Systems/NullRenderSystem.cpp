@@ -0,0 +1,52 @@
+#include <Tsubasa/Systems/NullRenderSystem.h>
+#include <Tsubasa/Application.h>
+#include <Tsubasa/Components/MeshRenderer.h>
+#include <algorithm>
+
+namespace Tsubasa
+{
+    NullRenderSystem::NullRenderSystem() : DrawList(drawList), Submitted(submitted), Culled(culled)
+    {
+        Options.ScreenWidth = 1920;
+        Options.ScreenHeight = 1080;
+        Options.WindowTitle = "Tsubasa Engine";
+        Options.Fullscreen = false;
+        Options.VSync = false;
+        submitted = 0;
+        culled = 0;
+    }
+
+    NullRenderSystem::NullRenderSystem(LaunchOptions options) : DrawList(drawList), Submitted(submitted), Culled(culled)
+    {
+        Options = options;
+        submitted = 0;
+        culled = 0;
+    }
+
+    NullRenderSystem::~NullRenderSystem() {}
+
+    bool NullRenderSystem::OnUpdate(float timeDelta)
+    {
+        drawList.clear();
+        submitted = 0;
+        culled = 0;
+        const std::shared_ptr<Camera> &camera = Client->ActiveCamera;
+        if (camera == nullptr || camera->Entity == nullptr)
+        {
+            return true;
+        }
+
+        const float aspect = Options.ScreenWidth / (float)std::max(Options.ScreenHeight, 1);
+        culling.Run(*Client, *camera, aspect);
+        submitted = culling.Submitted;
+        culled = culling.Culled;
+        for (const auto &entry : culling.Visible)
+        {
+            drawList.push_back({entry.Transform, entry.RenderModel, entry.Depth});
+        }
+
+        std::sort(drawList.begin(), drawList.end(), [](const DrawCommand &a, const DrawCommand &b)
+                  { return a.Depth < b.Depth; });
+        return true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Tsubasa/System.h>
+#include <Tsubasa/Components/Camera.h>
+#include <Tsubasa/Math/Affine3x4.h>
+#include <Tsubasa/Rendering/CullingStage.h>
+#include <Tsubasa/Systems/LaunchOptions.h>
+#include <cstddef>
+#include <vector>
+
+namespace Tsubasa
+{
+    class Model;
+
+    // Render system without a window or graphics context, for servers and
+    // CI. It culls and builds the draw list like a real renderer but never
+    // submits it, so the CPU side of rendering can be measured on its own.
+    class NullRenderSystem : public System
+    {
+    public:
+        struct DrawCommand
+        {
+            Affine3x4 Transform;
+            // Model of the selected level of detail
+            const Model *RenderModel;
+            // Distance along the view direction, the list is sorted front to back
+            float Depth;
+        };
+
+        NullRenderSystem();
+        NullRenderSystem(LaunchOptions options);
+        ~NullRenderSystem();
+
+        bool OnUpdate(float timeDelta) override;
+
+        // Only the screen size is used, for the aspect ratio
+        LaunchOptions Options;
+
+        // Draw list of the last frame
+        const std::vector<DrawCommand> &DrawList;
+        // Enabled renderers seen and culled in the last frame
+        const size_t &Submitted;
+        const size_t &Culled;
+
+    private:
+        CullingStage culling;
+        std::vector<DrawCommand> drawList;
+        size_t submitted;
+        size_t culled;
+    };
+}
\ No newline at end of file
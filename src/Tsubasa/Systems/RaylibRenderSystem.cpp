@@ -3,22 +3,58 @@
 #include <Tsubasa/Components/MeshRenderer.h>
 #include <raylib/raylib.h>
 #include <raylib/rlgl.h>
+#include <cstring>
 #include <math.h>
 
+static_assert(sizeof(::Matrix) == 16 * sizeof(float));
+
 namespace Tsubasa
 {
-    RaylibRenderSystem::RaylibRenderSystem()
+    namespace
+    {
+        // Default raylib shading, with the model matrix read per instance
+        const char *InstancingVertexShader = R"(#version 330
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec4 vertexColor;
+in mat4 instanceTransform;
+uniform mat4 mvp;
+out vec2 fragTexCoord;
+out vec4 fragColor;
+void main()
+{
+    fragTexCoord = vertexTexCoord;
+    fragColor = vertexColor;
+    gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0);
+})";
+        const char *InstancingFragmentShader = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+out vec4 finalColor;
+void main()
+{
+    finalColor = texture(texture0, fragTexCoord) * colDiffuse * fragColor;
+})";
+    }
+
+    RaylibRenderSystem::RaylibRenderSystem() : DrawCalls(drawCalls), StateChanges(stateChanges)
     {
         Options.ScreenWidth = 1920;
         Options.ScreenHeight = 1080;
         Options.WindowTitle = "Tsubasa Engine";
         Options.Fullscreen = true;
         Options.VSync = true;
+        drawCalls = 0;
+        stateChanges = 0;
     }
 
-    RaylibRenderSystem::RaylibRenderSystem(LaunchOptions options)
+    RaylibRenderSystem::RaylibRenderSystem(LaunchOptions options) : DrawCalls(drawCalls), StateChanges(stateChanges)
     {
         Options = options;
+        drawCalls = 0;
+        stateChanges = 0;
     }
 
     RaylibRenderSystem::~RaylibRenderSystem() {}
@@ -37,6 +73,13 @@ namespace Tsubasa
         SetConfigFlags(flags);
         InitWindow(Options.ScreenWidth, Options.ScreenHeight, Options.WindowTitle.c_str());
         SetExitKey(KEY_NULL);
+        // Without instancing support every renderer is drawn on its own
+        ::Shader shader = LoadShaderFromMemory(InstancingVertexShader, InstancingFragmentShader);
+        if (IsShaderReady(shader))
+        {
+            shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(shader, "instanceTransform");
+            instancingShader = std::make_shared<::Shader>(shader);
+        }
     }
 
     bool RaylibRenderSystem::OnUpdate(float timeDelta)
@@ -51,12 +94,14 @@ namespace Tsubasa
         if (Client->ActiveCamera != nullptr && Client->ActiveCamera->Entity != nullptr)
         {
             beginMode3D(Client->ActiveCamera);
-            Client->Root->Traverse<MeshRenderer>([this](const std::shared_ptr<MeshRenderer> &meshRenderer)
-                                                 {
-                if (meshRenderer->Enabled)
-                {
-                    renderModel(meshRenderer);
-                } });
+            const float aspect = GetRenderWidth() / (float)GetRenderHeight();
+            culling.Run(*Client, *Client->ActiveCamera, aspect);
+            queue.Clear();
+            for (const auto &entry : culling.Visible)
+            {
+                queueModel(entry);
+            }
+            drawQueue();
             EndMode3D();
         }
         EndDrawing();
@@ -65,6 +110,11 @@ namespace Tsubasa
 
     void RaylibRenderSystem::OnExit()
     {
+        if (instancingShader != nullptr)
+        {
+            UnloadShader(*instancingShader);
+            instancingShader = nullptr;
+        }
         CloseWindow();
     }
 
@@ -82,10 +132,10 @@ namespace Tsubasa
         if (camera->Projection == CameraProjection::Perspective)
         {
             // Setup perspective projection
-            double top = RL_CULL_DISTANCE_NEAR * tan(camera->FieldOfView * 0.5f * DEG2RAD);
+            double top = camera->NearPlane * tan(camera->FieldOfView * 0.5f * DEG2RAD);
             double right = top * aspect;
 
-            rlFrustum(-right, right, -top, top, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+            rlFrustum(-right, right, -top, top, camera->NearPlane, camera->FarPlane);
         }
         else if (camera->Projection == CameraProjection::Orthographic)
         {
@@ -93,7 +143,7 @@ namespace Tsubasa
             double top = camera->FieldOfView / 2.0f;
             double right = top * aspect;
 
-            rlOrtho(-right, right, -top, top, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+            rlOrtho(-right, right, -top, top, camera->NearPlane, camera->FarPlane);
         }
 
         rlMatrixMode(RL_MODELVIEW); // Switch back to modelview matrix
@@ -106,37 +156,105 @@ namespace Tsubasa
         rlEnableDepthTest(); // Enable DEPTH_TEST for 3D
     }
 
-    void RaylibRenderSystem::renderModel(std::shared_ptr<MeshRenderer> meshRenderer)
+    void RaylibRenderSystem::queueModel(const CullingStage::Entry &entry)
     {
-        if (meshRenderer->RenderModel != nullptr && meshRenderer->RenderModel->model != nullptr)
+        const Model *model = entry.RenderModel;
+        if (model == nullptr || model->model == nullptr)
+        {
+            return;
+        }
+        const ::Model &source = *model->model;
+        for (int mesh = 0; mesh < source.meshCount; mesh++)
         {
-            for (int i = 0; i < meshRenderer->RenderModel->model->meshCount; i++)
+            const ::Material &material = source.materials[source.meshMaterial[mesh]];
+            // Keyed by the shader drawQueue() binds
+            const unsigned int shader = instancingShader != nullptr ? instancingShader->id : material.shader.id;
+            const uint64_t key = RenderQueue::MakeKey(entry.Renderer->Transparent, shader,
+                                                      queue.GetStateId(&material), queue.GetStateId(&source.meshes[mesh]), entry.Depth);
+            queue.Add(key, model, mesh, entry.Transform);
+        }
+    }
+
+    void RaylibRenderSystem::drawQueue()
+    {
+        queue.Sort();
+        drawCalls = 0;
+        stateChanges = 0;
+        unsigned int shader = 0;
+        const ::Material *material = nullptr;
+        const ::Mesh *mesh = nullptr;
+        bool transparent = false;
+        size_t first = 0;
+        while (first < queue.GetSize())
+        {
+            // Neighbours drawing the same mesh with the same blending form one run
+            const RenderQueue::Item &item = queue[first];
+            const bool itemTransparent = RenderQueue::IsTransparent(item.Key);
+            size_t last = first + 1;
+            while (last < queue.GetSize() && queue[last].RenderModel == item.RenderModel && queue[last].Mesh == item.Mesh &&
+                   RenderQueue::IsTransparent(queue[last].Key) == itemTransparent)
+            {
+                last++;
+            }
+            // The rows of an affine transform followed by 0 0 0 1 are exactly
+            // the layout of a raylib matrix
+            instances.resize(last - first);
+            for (size_t i = first; i < last; i++)
+            {
+                InstanceTransform &transform = instances[i - first];
+                std::memcpy(transform.m, queue[i].Transform.m, sizeof(queue[i].Transform.m));
+                transform.m[12] = 0.0f;
+                transform.m[13] = 0.0f;
+                transform.m[14] = 0.0f;
+                transform.m[15] = 1.0f;
+            }
+
+            const ::Model &model = *item.RenderModel->model;
+            const ::Material &itemMaterial = model.materials[model.meshMaterial[item.Mesh]];
+            const ::Mesh &itemMesh = model.meshes[item.Mesh];
+            ::Material drawMaterial = itemMaterial;
+            const bool instanced = instancingShader != nullptr;
+            if (instanced)
+            {
+                drawMaterial.shader = *instancingShader;
+            }
+            stateChanges += (drawMaterial.shader.id != shader) + (&itemMaterial != material) + (&itemMesh != mesh);
+            shader = drawMaterial.shader.id;
+            material = &itemMaterial;
+            mesh = &itemMesh;
+            if (itemTransparent != transparent)
+            {
+                // Transparent items are tested against the opaque depth but do not write it
+                transparent = itemTransparent;
+                if (transparent)
+                {
+                    rlDisableDepthMask();
+                }
+                else
+                {
+                    rlEnableDepthMask();
+                }
+            }
+
+            const ::Matrix *transforms = reinterpret_cast<const ::Matrix *>(instances.data());
+            if (instanced)
             {
-                ::Matrix transform;
-                transform.m0 = meshRenderer->Entity->Transform.m[0];
-                transform.m1 = meshRenderer->Entity->Transform.m[1];
-                transform.m2 = meshRenderer->Entity->Transform.m[2];
-                transform.m3 = meshRenderer->Entity->Transform.m[3];
-                transform.m4 = meshRenderer->Entity->Transform.m[4];
-                transform.m5 = meshRenderer->Entity->Transform.m[5];
-                transform.m6 = meshRenderer->Entity->Transform.m[6];
-                transform.m7 = meshRenderer->Entity->Transform.m[7];
-                transform.m8 = meshRenderer->Entity->Transform.m[8];
-                transform.m9 = meshRenderer->Entity->Transform.m[9];
-                transform.m10 = meshRenderer->Entity->Transform.m[10];
-                transform.m11 = meshRenderer->Entity->Transform.m[11];
-                transform.m12 = meshRenderer->Entity->Transform.m[12];
-                transform.m13 = meshRenderer->Entity->Transform.m[13];
-                transform.m14 = meshRenderer->Entity->Transform.m[14];
-                transform.m15 = meshRenderer->Entity->Transform.m[15];
-                DrawMesh(meshRenderer->RenderModel->model->meshes[i], meshRenderer->RenderModel->model->materials[meshRenderer->RenderModel->model->meshMaterial[i]], transform);
-                // Vector3 position = Entity->GetWorldPosition();
-                // DrawCubeWires(::Vector3{position.x, position.y, position.z}, 1.0f, 1.0f, 1.0f, RED);
-                // position = Entity->TransformPoint(Vector3::Forward * 0.5f);
-                // DrawCubeWires(::Vector3{position.x, position.y, position.z}, 0.5f, 0.5f, 0.5f, GREEN);
-                // position = Entity->TransformPoint(Vector3::Up * 0.5f);
-                // DrawCubeWires(::Vector3{position.x, position.y, position.z}, 0.5f, 0.5f, 0.5f, BLUE);
+                DrawMeshInstanced(itemMesh, drawMaterial, transforms, static_cast<int>(instances.size()));
+                drawCalls++;
             }
+            else
+            {
+                for (size_t instance = 0; instance < instances.size(); instance++)
+                {
+                    DrawMesh(itemMesh, drawMaterial, transforms[instance]);
+                    drawCalls++;
+                }
+            }
+            first = last;
+        }
+        if (transparent)
+        {
+            rlEnableDepthMask();
         }
     }
 }
\ No newline at end of file
@@ -2,20 +2,26 @@
 
 #include <Tsubasa/System.h>
 #include <Tsubasa/Components/Camera.h>
-#include <string>
+#include <Tsubasa/Math/Affine3x4.h>
+#include <Tsubasa/Rendering/CullingStage.h>
+#include <Tsubasa/Rendering/RenderQueue.h>
+#include <Tsubasa/Systems/LaunchOptions.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+struct Shader;
 
 namespace Tsubasa
 {
-    struct LaunchOptions
-    {
-        int ScreenWidth;
-        int ScreenHeight;
-        std::string WindowTitle;
-        bool Fullscreen;
-        bool VSync;
-    };
-
-    class MeshRenderer;
+    // Renderers outside the camera frustum are culled first, and the rest
+    // get their level of detail picked. Every mesh of a visible renderer
+    // becomes an item of a render queue, sorted to minimise state changes.
+    // Neighbouring items of the same mesh are drawn together with
+    // DrawMeshInstanced. With instancing available every item goes through
+    // the instancing shader, single ones included, so the shader the queue
+    // sorts by is the one bound; without it items fall back to plain draws
+    // with their material shader.
 
     class RaylibRenderSystem : public System
     {
@@ -29,9 +35,28 @@ namespace Tsubasa
         void OnExit() override;
 
         LaunchOptions Options;
-    
+
+        // Draw calls issued and shader, material or mesh bindings that
+        // differed from the previous draw, in the last frame
+        const size_t &DrawCalls;
+        const size_t &StateChanges;
+
     private:
+        // Row-major column-vector matrix in the memory layout of ::Matrix
+        struct InstanceTransform
+        {
+            float m[16];
+        };
+
+        CullingStage culling;
+        RenderQueue queue;
+        std::shared_ptr<::Shader> instancingShader;
+        std::vector<InstanceTransform> instances;
+        size_t drawCalls;
+        size_t stateChanges;
+
         void beginMode3D(std::shared_ptr<Camera> camera);
-        void renderModel(std::shared_ptr<MeshRenderer> meshRenderer);
+        void queueModel(const CullingStage::Entry &entry);
+        void drawQueue();
     };
 }
\ No newline at end of file
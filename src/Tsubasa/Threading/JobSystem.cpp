@@ -0,0 +1,217 @@
+#include <Tsubasa/Threading/JobSystem.h>
+#include <algorithm>
+
+namespace Tsubasa
+{
+    namespace
+    {
+        thread_local const JobSystem *currentSystem = nullptr;
+        thread_local uint32_t currentIndex = 0;
+    }
+
+    JobCounter::JobCounter()
+    {
+        pending = 0;
+    }
+
+    bool JobCounter::IsDone() const
+    {
+        return pending.load(std::memory_order_acquire) == 0;
+    }
+
+    JobSystem::JobSystem()
+    {
+        unsigned int cores = std::thread::hardware_concurrency();
+        start(cores > 1 ? cores - 1 : 0);
+    }
+
+    JobSystem::JobSystem(const unsigned int &threadCount)
+    {
+        start(threadCount);
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    void JobSystem::Schedule(const std::function<void()> &job, JobCounter *counter, JobCounter *dependency)
+    {
+        if (counter != nullptr)
+        {
+            counter->pending.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (dependency != nullptr)
+        {
+            std::lock_guard<std::mutex> lock(dependency->mutex);
+            if (!dependency->IsDone())
+            {
+                dependency->continuations.push_back({job, counter});
+                return;
+            }
+        }
+        push({job, counter});
+    }
+
+    void JobSystem::Wait(JobCounter &counter)
+    {
+        while (!counter.IsDone())
+        {
+            if (!runOne())
+            {
+                std::this_thread::yield();
+            }
+        }
+        // The last job may still be releasing the counter's lock
+        std::lock_guard<std::mutex> lock(counter.mutex);
+    }
+
+    void JobSystem::ParallelFor(const uint32_t &count, const uint32_t &grain, const std::function<void(uint32_t begin, uint32_t end)> &body)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        uint32_t step = std::max(grain, 1u);
+        if (threads.empty() || count <= step)
+        {
+            body(0, count);
+            return;
+        }
+        JobCounter counter;
+        for (uint32_t begin = 0; begin < count; begin += step)
+        {
+            uint32_t end = std::min(begin + step, count);
+            Schedule([&body, begin, end]
+                     { body(begin, end); }, &counter);
+        }
+        Wait(counter);
+    }
+
+    unsigned int JobSystem::ThreadCount() const
+    {
+        return static_cast<unsigned int>(threads.size());
+    }
+
+    void JobSystem::start(const unsigned int &threadCount)
+    {
+        queued = 0;
+        stopping = false;
+        // Queue 0 belongs to the thread that owns the system
+        for (unsigned int i = 0; i <= threadCount; i++)
+        {
+            queues.push_back(std::make_unique<WorkQueue>());
+        }
+        for (unsigned int i = 0; i < threadCount; i++)
+        {
+            threads.emplace_back(&JobSystem::work, this, i + 1);
+        }
+    }
+
+    void JobSystem::work(const uint32_t &index)
+    {
+        currentSystem = this;
+        currentIndex = index;
+        while (true)
+        {
+            if (runOne())
+            {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this]
+                      { return stopping || queued.load(std::memory_order_relaxed) > 0; });
+            if (stopping)
+            {
+                return;
+            }
+        }
+    }
+
+    void JobSystem::push(Job job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            queued.fetch_add(1, std::memory_order_relaxed);
+        }
+        WorkQueue &queue = *queues[currentQueue()];
+        {
+            std::lock_guard<std::mutex> lock(queue.Mutex);
+            queue.Jobs.push_back(std::move(job));
+        }
+        wake.notify_one();
+    }
+
+    bool JobSystem::runOne()
+    {
+        const uint32_t own = currentQueue();
+        const uint32_t queueCount = static_cast<uint32_t>(queues.size());
+        Job job;
+        for (uint32_t i = 0; i < queueCount; i++)
+        {
+            if (take((own + i) % queueCount, job))
+            {
+                queued.fetch_sub(1, std::memory_order_relaxed);
+                job.Function();
+                finish(job.Counter);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool JobSystem::take(const uint32_t &index, Job &job)
+    {
+        WorkQueue &queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+        if (queue.Jobs.empty())
+        {
+            return false;
+        }
+        // The owner takes its newest job, thieves take the oldest one
+        if (index == currentQueue())
+        {
+            job = std::move(queue.Jobs.back());
+            queue.Jobs.pop_back();
+        }
+        else
+        {
+            job = std::move(queue.Jobs.front());
+            queue.Jobs.pop_front();
+        }
+        return true;
+    }
+
+    void JobSystem::finish(JobCounter *counter)
+    {
+        if (counter == nullptr)
+        {
+            return;
+        }
+        std::vector<JobCounter::Continuation> ready;
+        {
+            std::lock_guard<std::mutex> lock(counter->mutex);
+            if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                ready.swap(counter->continuations);
+            }
+        }
+        for (auto &continuation : ready)
+        {
+            push({std::move(continuation.Function), continuation.Counter});
+        }
+    }
+
+    uint32_t JobSystem::currentQueue() const
+    {
+        return currentSystem == this ? currentIndex : 0;
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Tsubasa
+{
+    class JobSystem;
+
+    // Counts the unfinished jobs of a group. Jobs scheduled with a dependency
+    // on a counter are held back until it drops to zero.
+    class JobCounter
+    {
+        friend class JobSystem;
+
+    public:
+        JobCounter();
+        JobCounter(const JobCounter &) = delete;
+        JobCounter &operator=(const JobCounter &) = delete;
+
+        bool IsDone() const;
+
+    private:
+        struct Continuation
+        {
+            std::function<void()> Function;
+            JobCounter *Counter;
+        };
+
+        std::atomic<uint32_t> pending;
+        std::mutex mutex;
+        std::vector<Continuation> continuations;
+    };
+
+    // Task-based work-stealing scheduler. Every worker, plus the thread that
+    // owns the system, has its own deque: it pops its newest job and steals
+    // the oldest job of another deque when its own runs dry. Wait() keeps the
+    // calling thread busy with other jobs instead of blocking it.
+    class JobSystem
+    {
+    public:
+        JobSystem();
+        JobSystem(const unsigned int &threadCount);
+        ~JobSystem();
+
+        // Queues a job that counts towards `counter` and, if `dependency` is
+        // given, starts only once `dependency` is done
+        void Schedule(const std::function<void()> &job, JobCounter *counter = nullptr, JobCounter *dependency = nullptr);
+        // Runs queued jobs on the calling thread until `counter` is done
+        void Wait(JobCounter &counter);
+        // Splits [0, count) into jobs of `grain` items, returning once every
+        // job is done
+        void ParallelFor(const uint32_t &count, const uint32_t &grain, const std::function<void(uint32_t begin, uint32_t end)> &body);
+
+        unsigned int ThreadCount() const;
+
+    private:
+        struct Job
+        {
+            std::function<void()> Function;
+            JobCounter *Counter;
+        };
+
+        struct WorkQueue
+        {
+            std::mutex Mutex;
+            std::deque<Job> Jobs;
+        };
+
+        std::vector<std::unique_ptr<WorkQueue>> queues;
+        std::vector<std::thread> threads;
+        std::atomic<uint32_t> queued;
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+        bool stopping;
+
+        void start(const unsigned int &threadCount);
+        void work(const uint32_t &index);
+        void push(Job job);
+        bool runOne();
+        bool take(const uint32_t &index, Job &job);
+        void finish(JobCounter *counter);
+        uint32_t currentQueue() const;
+    };
+}
@@ -0,0 +1,600 @@
+#include <Tsubasa/TransformStore.h>
+#include <Tsubasa/Node.h>
+#include <Tsubasa/Math/Batch.h>
+#include <algorithm>
+
+namespace Tsubasa
+{
+    TransformStore::TransformStore() : LocalPositions(localPositions), LocalRotations(localRotations), LocalScales(localScales), Worlds(worlds), WorldRotations(worldRotations), WorldScales(worldScales), Parents(parents), Versions(versions)
+    {
+        // Slots start with step zero, so they never match a step taken
+        step = 1;
+        stepping = false;
+        sorted = true;
+        levelsValid = false;
+    }
+
+    TransformStore::~TransformStore() {}
+
+    uint32_t TransformStore::Allocate(Node *owner)
+    {
+        uint32_t index;
+        if (!freeSlots.empty())
+        {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(owners.size());
+            localPositions.emplace_back();
+            localRotations.emplace_back();
+            localScales.emplace_back();
+            worlds.emplace_back();
+            worldRotations.emplace_back();
+            worldScales.emplace_back();
+            previousPoses.emplace_back();
+            fixedPoses.emplace_back();
+            previousSteps.emplace_back();
+            fixedSteps.emplace_back();
+            parents.emplace_back();
+            versions.emplace_back(0);
+            firstChildren.emplace_back();
+            nextSiblings.emplace_back();
+            previousSiblings.emplace_back();
+            subtreeSizes.emplace_back();
+            dirty.emplace_back(false);
+            owners.emplace_back();
+        }
+        // A recycled slot keeps its dirty flag, it may still be listed in dirtyRoots
+        localPositions[index] = Vector3::Zero;
+        localRotations[index] = Quaternion::Identity;
+        localScales[index] = Vector3::One;
+        worlds[index] = Affine3x4::Identity;
+        worldRotations[index] = Quaternion::Identity;
+        worldScales[index] = Vector3::One;
+        previousSteps[index] = 0;
+        fixedSteps[index] = 0;
+        parents[index] = Invalid;
+        versions[index]++;
+        firstChildren[index] = Invalid;
+        nextSiblings[index] = Invalid;
+        previousSiblings[index] = Invalid;
+        subtreeSizes[index] = 1;
+        owners[index] = owner;
+        levelsValid = false;
+        return index;
+    }
+
+    void TransformStore::Release(const uint32_t &index)
+    {
+        if (parents[index] != Invalid)
+        {
+            unlink(index);
+        }
+        owners[index] = nullptr;
+        freeSlots.push_back(index);
+        levelsValid = false;
+    }
+
+    void TransformStore::SetParent(const uint32_t &index, const uint32_t &parent)
+    {
+        if (parents[index] != Invalid)
+        {
+            unlink(index);
+        }
+        if (parent != Invalid)
+        {
+            link(index, parent);
+        }
+        levelsValid = false;
+        if (parent != Invalid && parent > index)
+        {
+            sorted = false;
+        }
+    }
+
+    void TransformStore::MakeDirty(const uint32_t &index)
+    {
+        if (!dirty[index])
+        {
+            dirty[index] = true;
+            dirtyRoots.push_back(index);
+        }
+    }
+
+    void TransformStore::Resolve(const uint32_t &index)
+    {
+        if (!dirtyRoots.empty())
+        {
+            refresh(index);
+        }
+    }
+
+    void TransformStore::Update(JobSystem *jobs)
+    {
+        if (dirtyRoots.empty())
+        {
+            return;
+        }
+        // Drop roots that already lie inside another dirty subtree
+        uint32_t touched = 0;
+        uint32_t live = static_cast<uint32_t>(owners.size() - freeSlots.size());
+        order.clear();
+        for (const auto &root : dirtyRoots)
+        {
+            if (owners[root] == nullptr || !dirty[root])
+            {
+                continue;
+            }
+            uint32_t ancestor = parents[root];
+            while (ancestor != Invalid && !dirty[ancestor])
+            {
+                ancestor = parents[ancestor];
+            }
+            if (ancestor == Invalid)
+            {
+                order.push_back(root);
+                touched += subtreeSizes[root];
+            }
+        }
+        if (!movedLogs.empty())
+        {
+            logMoved(live);
+        }
+        bool parallel = jobs != nullptr && jobs->ThreadCount() > 0 && touched >= ParallelThreshold;
+        if (parallel && touched * 2 >= live)
+        {
+            updateLevels(jobs);
+        }
+        else if (parallel && order.size() > 1)
+        {
+            // Subtrees under distinct roots never share a node
+            jobs->ParallelFor(static_cast<uint32_t>(order.size()), 1, [this](uint32_t begin, uint32_t end)
+                              {
+                thread_local std::vector<uint32_t> pending;
+                for (uint32_t i = begin; i < end; i++)
+                {
+                    updateSubtree(order[i], pending);
+                } });
+        }
+        else
+        {
+            for (const auto &root : order)
+            {
+                updateSubtree(root, stack);
+            }
+        }
+        for (const auto &root : dirtyRoots)
+        {
+            dirty[root] = false;
+        }
+        dirtyRoots.clear();
+    }
+
+    void TransformStore::BeginFixedStep()
+    {
+        step = step == UINT32_MAX ? 1 : step + 1;
+        stepping = true;
+    }
+
+    void TransformStore::EndFixedStep()
+    {
+        stepping = false;
+    }
+
+    Affine3x4 TransformStore::Interpolate(const uint32_t &index, const float &alpha) const
+    {
+        if (previousSteps[index] != step || alpha >= 1.0f)
+        {
+            return worlds[index];
+        }
+        const Pose current = getPose(index);
+        const Pose &previous = previousPoses[index];
+        const Pose fixed = fixedSteps[index] == step ? fixedPoses[index] : current;
+        const Vector3 position = current.Position + Vector3::Lerp(previous.Position, fixed.Position, alpha) - fixed.Position;
+        const Quaternion rotation = Quaternion::Slerp(previous.Rotation, fixed.Rotation, alpha) * Quaternion::Inverse(fixed.Rotation) * current.Rotation;
+        const Vector3 scale = current.Scale + Vector3::Lerp(previous.Scale, fixed.Scale, alpha) - fixed.Scale;
+        return Affine3x4::TRS(position, rotation, scale);
+    }
+
+    bool TransformStore::TakeMoved(const Application *client, std::vector<NodeHandle> &roots)
+    {
+        auto result = movedLogs.try_emplace(client);
+        MovedLog &log = result.first->second;
+        roots.clear();
+        roots.swap(log.Roots);
+        const bool complete = !result.second && !log.Overflow;
+        log.Overflow = false;
+        return complete;
+    }
+
+    void TransformStore::ReleaseMoved(const Application *client)
+    {
+        movedLogs.erase(client);
+    }
+
+    TransformStore &TransformStore::Shared()
+    {
+        static TransformStore store;
+        return store;
+    }
+
+    const uint32_t TransformStore::Invalid = UINT32_MAX;
+    const uint32_t TransformStore::ParallelThreshold = 4096;
+    const uint32_t TransformStore::ParallelGrain = 512;
+
+    void TransformStore::sort()
+    {
+        const uint32_t count = static_cast<uint32_t>(owners.size());
+        // Depth of every live slot, walking up until a slot with a known depth is found
+        depths.assign(count, Invalid);
+        uint32_t maxDepth = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (owners[i] == nullptr || depths[i] != Invalid)
+            {
+                continue;
+            }
+            order.clear();
+            uint32_t current = i;
+            while (current != Invalid && depths[current] == Invalid)
+            {
+                order.push_back(current);
+                current = parents[current];
+            }
+            uint32_t depth = current == Invalid ? 0 : depths[current] + 1;
+            for (auto it = order.rbegin(); it != order.rend(); ++it)
+            {
+                depths[*it] = depth++;
+            }
+            maxDepth = std::max(maxDepth, depth);
+        }
+        // Counting sort by depth keeps siblings in their current relative order
+        std::vector<uint32_t> offsets(maxDepth + 1, 0);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (owners[i] != nullptr)
+            {
+                offsets[depths[i]]++;
+            }
+        }
+        uint32_t live = 0;
+        for (auto &offset : offsets)
+        {
+            uint32_t size = offset;
+            offset = live;
+            live += size;
+        }
+        order.assign(live, Invalid);
+        std::vector<uint32_t> remap(count, Invalid);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (owners[i] != nullptr)
+            {
+                remap[i] = offsets[depths[i]]++;
+                order[remap[i]] = i;
+            }
+        }
+        // Permute every array into the new order
+        std::vector<Vector3> newPositions(live);
+        std::vector<Quaternion> newRotations(live);
+        std::vector<Vector3> newScales(live);
+        std::vector<Affine3x4> newWorlds(live);
+        std::vector<Quaternion> newWorldRotations(live);
+        std::vector<Vector3> newWorldScales(live);
+        std::vector<Pose> newPreviousPoses(live);
+        std::vector<Pose> newFixedPoses(live);
+        std::vector<uint32_t> newPreviousSteps(live);
+        std::vector<uint32_t> newFixedSteps(live);
+        std::vector<uint32_t> newParents(live);
+        std::vector<uint32_t> newVersions(live);
+        std::vector<uint8_t> newDirty(live);
+        std::vector<Node *> newOwners(live);
+        for (uint32_t i = 0; i < live; i++)
+        {
+            uint32_t old = order[i];
+            newPositions[i] = localPositions[old];
+            newRotations[i] = localRotations[old];
+            newScales[i] = localScales[old];
+            newWorlds[i] = worlds[old];
+            newWorldRotations[i] = worldRotations[old];
+            newWorldScales[i] = worldScales[old];
+            newPreviousPoses[i] = previousPoses[old];
+            newFixedPoses[i] = fixedPoses[old];
+            newPreviousSteps[i] = previousSteps[old];
+            newFixedSteps[i] = fixedSteps[old];
+            newParents[i] = parents[old] == Invalid ? Invalid : remap[parents[old]];
+            newVersions[i] = versions[old];
+            newDirty[i] = dirty[old];
+            newOwners[i] = owners[old];
+            newOwners[i]->transformIndex = i;
+        }
+        localPositions.swap(newPositions);
+        localRotations.swap(newRotations);
+        localScales.swap(newScales);
+        worlds.swap(newWorlds);
+        worldRotations.swap(newWorldRotations);
+        worldScales.swap(newWorldScales);
+        previousPoses.swap(newPreviousPoses);
+        fixedPoses.swap(newFixedPoses);
+        previousSteps.swap(newPreviousSteps);
+        fixedSteps.swap(newFixedSteps);
+        parents.swap(newParents);
+        versions.swap(newVersions);
+        dirty.swap(newDirty);
+        owners.swap(newOwners);
+        // Rebuild child links and subtree sizes, children always follow their parent
+        firstChildren.assign(live, Invalid);
+        nextSiblings.assign(live, Invalid);
+        previousSiblings.assign(live, Invalid);
+        subtreeSizes.assign(live, 1);
+        for (uint32_t i = live; i-- > 0;)
+        {
+            if (parents[i] != Invalid)
+            {
+                uint32_t parent = parents[i];
+                nextSiblings[i] = firstChildren[parent];
+                if (firstChildren[parent] != Invalid)
+                {
+                    previousSiblings[firstChildren[parent]] = i;
+                }
+                firstChildren[parent] = i;
+                subtreeSizes[parent] += subtreeSizes[i];
+            }
+        }
+        uint32_t roots = 0;
+        for (const auto &root : dirtyRoots)
+        {
+            if (remap[root] != Invalid)
+            {
+                dirtyRoots[roots++] = remap[root];
+            }
+        }
+        dirtyRoots.resize(roots);
+        freeSlots.clear();
+        sorted = true;
+        levelsValid = false;
+    }
+
+    void TransformStore::buildLevels()
+    {
+        // Slots are parent-sorted, so depths resolve in a single forward pass
+        const uint32_t count = static_cast<uint32_t>(owners.size());
+        depths.assign(count, Invalid);
+        levelOffsets.assign(1, 0);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (owners[i] != nullptr)
+            {
+                depths[i] = parents[i] == Invalid ? 0 : depths[parents[i]] + 1;
+                if (depths[i] + 1 >= levelOffsets.size())
+                {
+                    levelOffsets.resize(depths[i] + 2, 0);
+                }
+                levelOffsets[depths[i] + 1]++;
+            }
+        }
+        for (size_t level = 1; level < levelOffsets.size(); level++)
+        {
+            levelOffsets[level] += levelOffsets[level - 1];
+        }
+        levelOrder.resize(levelOffsets.back());
+        order.assign(levelOffsets.begin(), levelOffsets.end());
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (owners[i] != nullptr)
+            {
+                levelOrder[order[depths[i]]++] = i;
+            }
+        }
+        levelsValid = true;
+    }
+
+    void TransformStore::link(const uint32_t &index, const uint32_t &parent)
+    {
+        parents[index] = parent;
+        previousSiblings[index] = Invalid;
+        nextSiblings[index] = firstChildren[parent];
+        if (firstChildren[parent] != Invalid)
+        {
+            previousSiblings[firstChildren[parent]] = index;
+        }
+        firstChildren[parent] = index;
+        for (uint32_t ancestor = parent; ancestor != Invalid; ancestor = parents[ancestor])
+        {
+            subtreeSizes[ancestor] += subtreeSizes[index];
+        }
+    }
+
+    void TransformStore::unlink(const uint32_t &index)
+    {
+        uint32_t parent = parents[index];
+        for (uint32_t ancestor = parent; ancestor != Invalid; ancestor = parents[ancestor])
+        {
+            subtreeSizes[ancestor] -= subtreeSizes[index];
+        }
+        if (previousSiblings[index] != Invalid)
+        {
+            nextSiblings[previousSiblings[index]] = nextSiblings[index];
+        }
+        else
+        {
+            firstChildren[parent] = nextSiblings[index];
+        }
+        if (nextSiblings[index] != Invalid)
+        {
+            previousSiblings[nextSiblings[index]] = previousSiblings[index];
+        }
+        parents[index] = Invalid;
+        nextSiblings[index] = Invalid;
+        previousSiblings[index] = Invalid;
+    }
+
+    bool TransformStore::refresh(const uint32_t &index)
+    {
+        // Recomputes the stale part of the ancestor chain without clearing any
+        // dirty flag, the subtrees still belong to the next Update()
+        uint32_t parent = parents[index];
+        bool parentChanged = parent != Invalid && refresh(parent);
+        if (dirty[index] || parentChanged)
+        {
+            compute(index);
+            return true;
+        }
+        return false;
+    }
+
+    void TransformStore::compute(const uint32_t &index)
+    {
+        // Same kernel as the batched passes, keeping results bit-identical
+        computeBatch(&index, 1);
+    }
+
+    void TransformStore::computeBatch(const uint32_t *indices, const uint32_t &count)
+    {
+        Vector3 positions[BatchSize];
+        Quaternion rotations[BatchSize];
+        Vector3 scales[BatchSize];
+        Affine3x4 locals[BatchSize];
+        for (uint32_t offset = 0; offset < count; offset += BatchSize)
+        {
+            const uint32_t size = std::min(count - offset, BatchSize);
+            for (uint32_t i = 0; i < size; i++)
+            {
+                const uint32_t index = indices[offset + i];
+                positions[i] = localPositions[index];
+                rotations[i] = localRotations[index];
+                scales[i] = localScales[index];
+            }
+            TRSBatch(Span<const Vector3>(positions, size), Span<const Quaternion>(rotations, size), Span<const Vector3>(scales, size), Span<Affine3x4>(locals, size));
+            // In order, so a parent listed earlier is always finished first
+            for (uint32_t i = 0; i < size; i++)
+            {
+                const uint32_t index = indices[offset + i];
+                const uint32_t parent = parents[index];
+                snapshot(index);
+                versions[index]++;
+                if (parent != Invalid)
+                {
+                    worlds[index] = locals[i] * worlds[parent];
+                    worldRotations[index] = worldRotations[parent] * rotations[i];
+                    worldScales[index] = scales[i] * worldScales[parent];
+                }
+                else
+                {
+                    worlds[index] = locals[i];
+                    worldRotations[index] = rotations[i];
+                    worldScales[index] = scales[i];
+                }
+            }
+        }
+    }
+
+    void TransformStore::snapshot(const uint32_t &index)
+    {
+        // Runs before the world is overwritten, only the slot itself is touched
+        if (stepping)
+        {
+            if (previousSteps[index] != step)
+            {
+                previousPoses[index] = getPose(index);
+                previousSteps[index] = step;
+            }
+        }
+        else if (previousSteps[index] == step && fixedSteps[index] != step)
+        {
+            fixedPoses[index] = getPose(index);
+            fixedSteps[index] = step;
+        }
+    }
+
+    TransformStore::Pose TransformStore::getPose(const uint32_t &index) const
+    {
+        return {worlds[index].GetTranslation(), worldRotations[index], worldScales[index]};
+    }
+
+    void TransformStore::logMoved(const uint32_t &live)
+    {
+        // Roots of one client tend to come in runs, so the log is looked up
+        // only when the client changes. Detached subtrees belong to no log.
+        const Application *client = nullptr;
+        MovedLog *log = nullptr;
+        for (const auto &root : order)
+        {
+            const Application *owner = owners[root]->Client;
+            if (owner != client)
+            {
+                client = owner;
+                auto it = owner != nullptr ? movedLogs.find(owner) : movedLogs.end();
+                log = it != movedLogs.end() ? &it->second : nullptr;
+            }
+            if (log == nullptr || log->Overflow)
+            {
+                continue;
+            }
+            if (log->Roots.size() >= live)
+            {
+                log->Roots.clear();
+                log->Overflow = true;
+                continue;
+            }
+            log->Roots.push_back(owners[root]->GetHandle());
+        }
+    }
+
+    void TransformStore::updateSubtree(const uint32_t &root, std::vector<uint32_t> &pending)
+    {
+        // Breadth-first listing of the subtree, parents precede their children
+        pending.clear();
+        pending.push_back(root);
+        for (size_t i = 0; i < pending.size(); i++)
+        {
+            for (uint32_t child = firstChildren[pending[i]]; child != Invalid; child = nextSiblings[child])
+            {
+                pending.push_back(child);
+            }
+        }
+        computeBatch(pending.data(), static_cast<uint32_t>(pending.size()));
+    }
+
+    void TransformStore::updateLevels(JobSystem *jobs)
+    {
+        if (!sorted)
+        {
+            sort();
+        }
+        if (!levelsValid)
+        {
+            buildLevels();
+        }
+        // Every node of a level only reads flags and worlds of the previous
+        // level, so the result does not depend on scheduling. A recomputed
+        // node is flagged so that its children follow, and all flags are
+        // cleared afterwards.
+        for (size_t level = 0; level + 1 < levelOffsets.size(); level++)
+        {
+            const uint32_t *levelBegin = levelOrder.data() + levelOffsets[level];
+            const uint32_t levelSize = levelOffsets[level + 1] - levelOffsets[level];
+            jobs->ParallelFor(levelSize, ParallelGrain, [this, levelBegin](uint32_t begin, uint32_t end)
+                              {
+                thread_local std::vector<uint32_t> pending;
+                pending.clear();
+                for (uint32_t i = begin; i < end; i++)
+                {
+                    const uint32_t index = levelBegin[i];
+                    const uint32_t parent = parents[index];
+                    if (dirty[index] || (parent != Invalid && dirty[parent]))
+                    {
+                        pending.push_back(index);
+                    }
+                }
+                computeBatch(pending.data(), static_cast<uint32_t>(pending.size()));
+                for (const auto &index : pending)
+                {
+                    dirty[index] = true;
+                } });
+        }
+        std::fill(dirty.begin(), dirty.end(), 0);
+    }
+}
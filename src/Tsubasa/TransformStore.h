@@ -0,0 +1,141 @@
+#pragma once
+
+#include <Tsubasa/Handle.h>
+#include <Tsubasa/Math/Affine3x4.h>
+#include <Tsubasa/Math/Quaternion.h>
+#include <Tsubasa/Math/Vector3.h>
+#include <Tsubasa/Threading/JobSystem.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Tsubasa
+{
+    class Application;
+    class Node;
+
+    // Local TRS and affine world transforms of every node, kept in contiguous
+    // arrays. MakeDirty() only records the changed slot as a dirty subtree root, and
+    // Update() recomputes just the subtrees under those roots. When most of
+    // the store is dirty and a job system is given, it instead sweeps the
+    // store one depth level at a time, splitting each level across workers.
+    // Only that sweep needs parents to precede their children, so reparenting
+    // under a later slot just marks the order stale and the sweep restores it
+    // before it runs, at the cost it pays to visit every slot anyway.
+    // World rotation and scale are cached in the same pass. The world scale
+    // is the componentwise product of the local scales, it ignores the skew a
+    // rotated non-uniform parent scale leaves in the world transform.
+    class TransformStore
+    {
+        friend class Node;
+
+    public:
+        TransformStore();
+        ~TransformStore();
+
+        uint32_t Allocate(Node *owner);
+        void Release(const uint32_t &index);
+        void SetParent(const uint32_t &index, const uint32_t &parent);
+        void MakeDirty(const uint32_t &index);
+        void Resolve(const uint32_t &index);
+        void Update(JobSystem *jobs = nullptr);
+        // Mark a fixed step, Update() must have run before the first call.
+        // Nothing is copied here, a node records its world the first time it
+        // is recomputed during the step, and again the first time it moves
+        // after the step ended.
+        void BeginFixedStep();
+        void EndFixedStep();
+        // World transform with the motion of the last fixed step scaled by
+        // alpha, motion from outside fixed steps is kept as is. Translation
+        // and scale are blended linearly and rotation along the arc, from the
+        // cached world rotation and scale.
+        Affine3x4 Interpolate(const uint32_t &index, const float &alpha) const;
+        // Hands over the roots of the subtrees of client that Update()
+        // recomputed since the last call. Every client has a log of its own,
+        // kept from its first call until ReleaseMoved(). Returns false on the
+        // first call, and when more roots piled up than there are nodes, the
+        // log then stops and anything may have moved.
+        bool TakeMoved(const Application *client, std::vector<NodeHandle> &roots);
+        void ReleaseMoved(const Application *client);
+
+        static TransformStore &Shared();
+
+        static const uint32_t Invalid;
+        static const uint32_t ParallelThreshold;
+        static const uint32_t ParallelGrain;
+
+        const std::vector<Vector3> &LocalPositions;
+        const std::vector<Quaternion> &LocalRotations;
+        const std::vector<Vector3> &LocalScales;
+        const std::vector<Affine3x4> &Worlds;
+        const std::vector<Quaternion> &WorldRotations;
+        const std::vector<Vector3> &WorldScales;
+        const std::vector<uint32_t> &Parents;
+        // Bumped whenever a world is recomputed, so consumers such as the
+        // spatial index can tell which nodes moved since they last looked
+        const std::vector<uint32_t> &Versions;
+
+    private:
+        // Nodes gathered per call of the batched TRS
+        static constexpr uint32_t BatchSize = 64;
+
+        struct Pose
+        {
+            Vector3 Position;
+            Quaternion Rotation;
+            Vector3 Scale;
+        };
+
+        std::vector<Vector3> localPositions;
+        std::vector<Quaternion> localRotations;
+        std::vector<Vector3> localScales;
+        std::vector<Affine3x4> worlds;
+        std::vector<Quaternion> worldRotations;
+        std::vector<Vector3> worldScales;
+        // World before the last fixed step that moved the node, and at its
+        // end when the node moved again since, each valid for matching steps
+        std::vector<Pose> previousPoses;
+        std::vector<Pose> fixedPoses;
+        std::vector<uint32_t> previousSteps;
+        std::vector<uint32_t> fixedSteps;
+        std::vector<uint32_t> parents;
+        std::vector<uint32_t> versions;
+        std::vector<uint32_t> firstChildren;
+        std::vector<uint32_t> nextSiblings;
+        std::vector<uint32_t> previousSiblings;
+        std::vector<uint32_t> subtreeSizes;
+        std::vector<uint8_t> dirty;
+        std::vector<Node *> owners;
+        std::vector<uint32_t> freeSlots;
+        std::vector<uint32_t> dirtyRoots;
+        std::vector<uint32_t> depths;
+        std::vector<uint32_t> order;
+        std::vector<uint32_t> stack;
+        std::vector<uint32_t> levelOrder;
+        std::vector<uint32_t> levelOffsets;
+        struct MovedLog
+        {
+            std::vector<NodeHandle> Roots;
+            bool Overflow;
+        };
+
+        std::unordered_map<const Application *, MovedLog> movedLogs;
+        uint32_t step;
+        bool stepping;
+        bool sorted;
+        bool levelsValid;
+
+        void sort();
+        void buildLevels();
+        void link(const uint32_t &index, const uint32_t &parent);
+        void unlink(const uint32_t &index);
+        bool refresh(const uint32_t &index);
+        void compute(const uint32_t &index);
+        void snapshot(const uint32_t &index);
+        Pose getPose(const uint32_t &index) const;
+        void computeBatch(const uint32_t *indices, const uint32_t &count);
+        void logMoved(const uint32_t &live);
+        void updateSubtree(const uint32_t &root, std::vector<uint32_t> &pending);
+        void updateLevels(JobSystem *jobs);
+    };
+}
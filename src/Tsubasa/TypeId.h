@@ -0,0 +1,30 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Tsubasa
+{
+    // Sequential numeric IDs handed out per type within a family (components,
+    // systems, ...), so typed lookups can index tables instead of using RTTI.
+    // An ID is assigned the first time a type is seen and never changes.
+    template <typename Family>
+    class TypeId
+    {
+    public:
+        template <typename T>
+        static uint32_t Of()
+        {
+            static const uint32_t id = next++;
+            return id;
+        }
+
+        static uint32_t Count()
+        {
+            return next;
+        }
+
+    private:
+        static inline std::atomic<uint32_t> next{0};
+    };
+}
@@ -2,9 +2,11 @@
 #include <Tsubasa/Application.h>
 #include <Tsubasa/Components/Camera.h>
 #include <Tsubasa/Components/MeshRenderer.h>
+#include <Tsubasa/Systems/NullRenderSystem.h>
 #include <Tsubasa/Systems/RaylibRenderSystem.h>
 #include <memory>
 #include <iostream>
+#include <string>
 #include <raylib/raylib.h>
 
 using namespace std;
@@ -127,8 +129,19 @@ public:
     }
 };
 
-int main(void)
+int main(int argc, char **argv)
 {
+    // --headless [frames] runs the test scene at 60 Hz without a window
+    if (argc > 1 && std::string(argv[1]) == "--headless")
+    {
+        std::shared_ptr<Tsubasa::Application> app = std::make_shared<TestApplication>();
+        app->Pacer.TargetFrameRate = 60.0f;
+        app->MaxFrames = argc > 2 ? std::stoull(argv[2]) : 0;
+        auto renderer = app->AddSystem<Tsubasa::NullRenderSystem>();
+        app->Run();
+        cout << "Draw list: " << renderer->DrawList.size() << ", culled: " << renderer->Culled << endl;
+        return 0;
+    }
     // std::shared_ptr<Tsubasa::Application> app = std::make_shared<TestApplication>();
     // Tsubasa::LaunchOptions options;
     // options.ScreenWidth = 1280;